@@ -5,4 +5,97 @@
 #ifndef ENGINE_BACKEND_H
 #define ENGINE_BACKEND_H
 
-#endif //ENGINE_BACKEND_H
\ No newline at end of file
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Filters.h"
+#include "Frame.h"
+
+namespace engine {
+    namespace BackendCapability {
+        enum : uint32_t {
+            SIMD = 1u << 0,
+            MultiThreaded = 1u << 1,
+            GPU = 1u << 2
+        };
+    }
+
+    // Columns [begin, end) of each overlay row that are not fully transparent, so blending can skip the
+    // rest: the spans of row r are spans[rowSpans[r]] up to spans[rowSpans[r + 1]].
+    struct OverlaySpans {
+        struct Span {
+            int begin;
+            int end;
+        };
+
+        std::vector<Span> spans;
+        std::vector<int> rowSpans;
+    };
+
+    // Executes the per-frame pixel operations behind Engine and Filters. Backends are registered once;
+    // the available one with the highest priority (on a tie, the one with the most capabilities) is picked
+    // on first use, and ENGINE_BACKEND=<name> (or select()) forces a specific one, e.g. to A/B kernel
+    // implementations.
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+
+        [[nodiscard]] virtual const char *name() const = 0;
+
+        [[nodiscard]] virtual uint32_t capabilities() const = 0;
+
+        [[nodiscard]] virtual int priority() const = 0;
+
+        // Whether this machine can run it (CPU features, device present, ...)
+        [[nodiscard]] virtual bool isAvailable() const = 0;
+
+        // Called when the backend becomes the active one
+        virtual void activate() {
+        }
+
+        // Operations take views, so they work on a region of interest in place; Frames convert implicitly.
+
+        // RGB24 <-> RGBA32, color -> GRAY8, GRAY8 -> color, or a plain copy. Same dimensions.
+        virtual void convert(engine::ConstFrameView src, engine::FrameView dest) = 0;
+
+        // Luma written to the color channels, format kept
+        virtual void toGrayScale(engine::FrameView frame) = 0;
+
+        // Bilinear, src and dest in the same format; dest dimensions are the target size
+        virtual void resize(engine::ConstFrameView src, engine::FrameView dest) = 0;
+
+        // Separable filter, the kernel has already been validated. Edges of the view are replicated.
+        virtual void convolve(engine::FrameView frame, const Kernel1D &kernel) = 0;
+
+        // Straight-alpha RGBA32 to premultiplied RGBA32, same dimensions
+        virtual void premultiply(engine::ConstFrameView src, engine::FrameView dest) = 0;
+
+        // Premultiplied RGBA32 overlay drawn onto base (RGB24/RGBA32) at (x, y), clipped to base; the base
+        // alpha is kept. With spans, only those parts of each overlay row are drawn. Straight-alpha
+        // overlays are premultiplied first (Engine::blend, Compositor), so there is a single blend path.
+        virtual void blend(engine::ConstFrameView overlay, engine::FrameView base, int x, int y,
+                           const OverlaySpans *spans = nullptr) = 0;
+
+        static void registerBackend(std::shared_ptr<Backend> backend);
+
+        [[nodiscard]] static std::vector<std::shared_ptr<Backend> > registered();
+
+        static Backend &active();
+
+        // Makes the named backend active. Throws if it is unknown or unavailable.
+        static void select(const std::string &name);
+
+        // Back to automatic selection (ENGINE_BACKEND, else the best available), re-activated even when it
+        // already is, which restores its SIMD level. Throws like select() for an invalid ENGINE_BACKEND.
+        static void selectDefault();
+
+        // Registered backend with this name, nullptr if there is none
+        [[nodiscard]] static std::shared_ptr<Backend> find(const std::string &name);
+    };
+}
+
+#endif //ENGINE_BACKEND_H
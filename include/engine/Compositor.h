@@ -0,0 +1,72 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_COMPOSITOR_H
+#define ENGINE_COMPOSITOR_H
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Backend.h"
+#include "Error.h"
+#include "Frame.h"
+#include "Pipeline.h"
+
+namespace engine {
+    // Burns RGBA32 overlays (watermarks, captions, lower thirds) into RGB24/RGBA32 frames.
+    // Each overlay is premultiplied once when it is added, and the transparent parts of every row
+    // are skipped, so a static overlay costs only its visible pixels per frame. Both run on the active
+    // Backend, the same blend Engine::blend uses. Overlays are drawn
+    // in the order they were added, clipped to the frame; the frame's alpha channel is kept.
+    class Compositor final : public Stage {
+    public:
+        [[nodiscard]] const char *name() const override { return "Compositor"; }
+
+        engine::Expected<bool> process(engine::FrameView frame) override;
+
+        // Straight-alpha RGBA32 overlay drawn with its top-left corner at (x, y).
+        // Returns the id used by the other overlay calls; UnsupportedFormat for other formats.
+        engine::Expected<int> addOverlay(engine::ConstFrameView overlay, int x, int y);
+
+        // New content for an existing overlay (animated overlays), position kept.
+        // The calls taking an id return InvalidArgument for ids that were never added or were removed.
+        engine::Expected<void> updateOverlay(int id, engine::ConstFrameView overlay);
+
+        engine::Expected<void> moveOverlay(int id, int x, int y);
+
+        engine::Expected<void> setVisible(int id, bool visible);
+
+        engine::Expected<void> removeOverlay(int id);
+
+        void clear();
+
+        [[nodiscard]] std::size_t size() const { return layers.size(); }
+
+        // Draws every visible overlay onto base (RGB24/RGBA32)
+        engine::Expected<void> composite(engine::FrameView base) const;
+
+    private:
+        struct Layer {
+            int id = 0;
+            int x = 0;
+            int y = 0;
+            bool visible = true;
+
+            engine::Frame premultiplied;
+            OverlaySpans runs; // the non-transparent parts of premultiplied
+        };
+
+        // Null for unknown ids
+        Layer *find(int id);
+
+        static engine::Expected<void> prepare(Layer &layer, engine::ConstFrameView overlay);
+
+        std::vector<Layer> layers;
+        int nextId = 0;
+    };
+}
+
+#endif //ENGINE_COMPOSITOR_H
@@ -5,4 +5,87 @@
 #ifndef ENGINE_CONFIG_H
 #define ENGINE_CONFIG_H
 
-#endif //ENGINE_CONFIG_H
\ No newline at end of file
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "LogLevel.h"
+
+namespace engine {
+    // libswscale algorithm used when decoded frames are converted/scaled to the output format
+    enum class ScalerAlgorithm {
+        FastBilinear,
+        Bilinear,
+        Bicubic,
+        Area,
+        Point,
+        Lanczos
+    };
+
+    enum class SimdOverride {
+        Auto, // best level the CPU supports
+        Scalar,
+        AVX2
+    };
+
+    // Performance tunables, so they can be set per hardware class without recompiling.
+    //
+    // Files hold one `key = value` per line ('#' starts a comment); every key can also be set
+    // through an ENGINE_<KEY> environment variable (e.g. ENGINE_WORKER_THREADS=6). Keys:
+    //   scaler             fast_bilinear | bilinear | bicubic | area | point | lanczos
+    //   decoder_threads    FFmpeg decoding threads, 0 = FFmpeg's choice
+    //   io_buffer_size     custom input read buffer, bytes (K/M/G suffixes allowed)
+    //   low_latency        true | false: live input mode of Decoders and Pipelines (see Decoder::setLowLatency)
+    //   worker_threads     shared thread pool workers, 0 = hardware threads - 1
+    //   queue_depth        frames decoded ahead of the stages by Pipeline::run, 0 = no decode thread
+    //   backend            compute backend name, empty = best available
+    //   simd               auto | scalar | avx2
+    //   frame_cache_memory, frame_cache_dir, frame_cache_disk   shared FrameCache tiers
+    //   log_level          info | success | warn | error | off
+    struct Config {
+        // Decoding
+        ScalerAlgorithm scaler = ScalerAlgorithm::Bilinear;
+        int decoderThreads = 0;
+        int ioBufferSize = 64 * 1024;
+        bool lowLatency = false;
+
+        // Processing
+        int workerThreads = 0;
+        int queueDepth = 4;
+        std::string backend;
+        SimdOverride simd = SimdOverride::Auto;
+
+        // Frame cache
+        std::size_t frameCacheMemory = std::size_t{512} << 20;
+        std::string frameCacheDir;
+        std::size_t frameCacheDisk = std::size_t{4} << 30;
+
+        LogLevel logLevel = LogLevel::Info;
+
+        // Sets one key (see above) from its text form. Throws on unknown keys and invalid values.
+        void set(const std::string &key, const std::string &value);
+
+        // Values from the file over the defaults
+        static Config fromFile(const std::string &path);
+
+        // Every ENGINE_<KEY> environment variable that is set, over base (or the defaults)
+        static Config fromEnvironment(Config base);
+
+        static Config fromEnvironment();
+
+        // File (if the path isn't empty), then environment overrides
+        static Config load(const std::string &path = "");
+
+        // Applies the process-wide settings (thread pool, backend, SIMD level, frame cache, log level)
+        // and makes this the configuration new Decoders and Pipelines start from. Unset backend and
+        // simd = auto go back to automatic selection. Throws, with nothing applied, for an unavailable
+        // backend or SIMD level, or if worker_threads changes while processing runs on the thread pool.
+        void apply() const;
+
+        // Last applied configuration (defaults before the first apply())
+        static Config current();
+    };
+}
+
+#endif //ENGINE_CONFIG_H
@@ -8,6 +8,8 @@
 
 #include <string>
 
+#include "Config.h"
+#include "Error.h"
 #include "Frame.h"
 
 namespace engine {
@@ -15,15 +17,27 @@ namespace engine {
     public:
         static void process(const std::string &input, const std::string &output);
 
-        static void savePPM(const engine::Frame &Frame, const std::string &output);
+        // Applies the process-wide settings of config (see Config::apply)
+        static void configure(const engine::Config &config);
 
-        static void savePAM(const engine::Frame &frame, const std::string &output);
+        // Per-frame operations report bad input and failed writes through the result instead of throwing
+        static engine::Expected<void> savePPM(const engine::ConstFrameView &frame, const std::string &output);
 
-        static void savePGM(const engine::Frame &frame, const std::string &output);
+        static engine::Expected<void> savePAM(const engine::ConstFrameView &frame, const std::string &output);
 
-        static void toGrayScale(engine::Frame &frame);
+        static engine::Expected<void> savePGM(const engine::ConstFrameView &frame, const std::string &output);
 
-        static void convertRGB24toRGBA32(const engine::Frame &src, engine::Frame &dest);
+        // Every operation below takes frame views, so it works on a whole Frame or on a region of one
+        static engine::Expected<void> toGrayScale(engine::FrameView frame);
+
+        static engine::Expected<void> convertRGB24toRGBA32(engine::ConstFrameView src, engine::FrameView dest);
+
+        // Bilinear resize to dest's dimensions, src and dest in the same pixel format
+        static engine::Expected<void> resize(engine::ConstFrameView src, engine::FrameView dest);
+
+        // Draws a straight-alpha RGBA32 overlay onto base (RGB24/RGBA32) at (x, y), clipped to base.
+        // Same result as a Compositor overlay: premultiplied, then blended by the active Backend.
+        static engine::Expected<void> blend(engine::ConstFrameView overlay, engine::FrameView base, int x, int y);
     };
 }
 
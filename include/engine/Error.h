@@ -5,4 +5,129 @@
 #ifndef ENGINE_ERROR_H
 #define ENGINE_ERROR_H
 
-#endif //ENGINE_ERROR_H
\ No newline at end of file
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <variant>
+
+namespace engine {
+    enum class ErrorCode : uint8_t {
+        EndOfStream, // no more frames: the normal end of a read loop
+        TryAgain, // nothing available yet (live input), call again later
+        CorruptData, // a packet or frame could not be decoded
+        UnsupportedFormat,
+        IOFailure,
+        InvalidArgument,
+        InvalidState // e.g. reading before open()
+    };
+
+    inline const char *toString(const ErrorCode code) {
+        switch (code) {
+            case ErrorCode::EndOfStream: return "end of stream";
+            case ErrorCode::TryAgain: return "try again";
+            case ErrorCode::CorruptData: return "corrupt data";
+            case ErrorCode::UnsupportedFormat: return "unsupported format";
+            case ErrorCode::IOFailure: return "I/O failure";
+            case ErrorCode::InvalidArgument: return "invalid argument";
+            case ErrorCode::InvalidState: return "invalid state";
+        }
+        return "unknown error";
+    }
+
+    // Failure reported by value on per-frame paths, where exceptions would cost an unwind per frame.
+    // Cheap to copy: the message is static text.
+    struct Error {
+        ErrorCode code = ErrorCode::IOFailure;
+        const char *message = "";
+        int native = 0; // underlying FFmpeg (AVERROR) or OS error code, 0 if none
+    };
+
+    // Value or Error. Tests true on success, so `while (decoder.readFrame_RGB24(frame))` keeps working;
+    // on false, error() tells the end of the stream apart from a failure.
+    template<typename T>
+    class [[nodiscard]] Expected {
+    public:
+        Expected(T value) : storage(std::in_place_index<0>, std::move(value)) {
+        }
+
+        Expected(const Error error) : storage(std::in_place_index<1>, error) {
+        }
+
+        explicit operator bool() const noexcept { return storage.index() == 0; }
+
+        [[nodiscard]] bool hasValue() const noexcept { return storage.index() == 0; }
+
+        // Throws std::runtime_error with the error message if there is no value
+        T &value() & {
+            check();
+            return std::get<0>(storage);
+        }
+
+        const T &value() const & {
+            check();
+            return std::get<0>(storage);
+        }
+
+        T &&value() && {
+            check();
+            return std::get<0>(std::move(storage));
+        }
+
+        T valueOr(T fallback) const {
+            return hasValue() ? std::get<0>(storage) : std::move(fallback);
+        }
+
+        T &operator*() & { return std::get<0>(storage); }
+
+        const T &operator*() const & { return std::get<0>(storage); }
+
+        T *operator->() { return &std::get<0>(storage); }
+
+        const T *operator->() const { return &std::get<0>(storage); }
+
+        // Only valid without a value
+        [[nodiscard]] const Error &error() const { return std::get<1>(storage); }
+
+        [[nodiscard]] bool is(const ErrorCode code) const noexcept {
+            return !hasValue() && std::get<1>(storage).code == code;
+        }
+
+    private:
+        void check() const {
+            if (!hasValue()) throw std::runtime_error(std::get<1>(storage).message);
+        }
+
+        std::variant<T, Error> storage;
+    };
+
+    template<>
+    class [[nodiscard]] Expected<void> {
+    public:
+        Expected() = default;
+
+        Expected(const Error error) : failure(error), failed(true) {
+        }
+
+        explicit operator bool() const noexcept { return !failed; }
+
+        [[nodiscard]] bool hasValue() const noexcept { return !failed; }
+
+        // Throws std::runtime_error with the error message on failure
+        void value() const {
+            if (failed) throw std::runtime_error(failure.message);
+        }
+
+        // Only valid on failure
+        [[nodiscard]] const Error &error() const { return failure; }
+
+        [[nodiscard]] bool is(const ErrorCode code) const noexcept { return failed && failure.code == code; }
+
+    private:
+        Error failure;
+        bool failed = false;
+    };
+}
+
+#endif //ENGINE_ERROR_H
@@ -0,0 +1,53 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_FILTERS_H
+#define ENGINE_FILTERS_H
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "Error.h"
+#include "Frame.h"
+
+namespace engine {
+    // Symmetric 1-D kernel with Q8 weights summing to 256. The factories throw std::runtime_error on an
+    // out of range radius or sigma.
+    struct Kernel1D {
+        std::vector<uint16_t> weights;
+
+        [[nodiscard]] int radius() const { return static_cast<int>(weights.size()) / 2; }
+
+        static Kernel1D box(int radius);
+
+        static Kernel1D gaussian(double sigma);
+    };
+
+    // Separable filters on RGB24, RGBA32 and GRAY8 frames. Convolutions run on the active Backend
+    // (parallel, cache-blocked tiles on the CPU backend). Run them on GRAY8/luma frames where
+    // color isn't needed. Frames are taken as views, so filtering a region leaves the rest untouched;
+    // edges are replicated at the region border.
+    // Unsupported pixel formats and out of range parameters are reported as UnsupportedFormat and
+    // InvalidArgument; the frame is left untouched then.
+    class Filters {
+    public:
+        // Same kernel horizontally and vertically, edges replicated
+        static engine::Expected<void> convolve(engine::FrameView frame, const Kernel1D &kernel);
+
+        // radius in [0, 31]
+        static engine::Expected<void> boxBlur(engine::FrameView frame, int radius);
+
+        static engine::Expected<void> gaussianBlur(engine::FrameView frame, double sigma);
+
+        // frame += amount * (frame - gaussianBlur(frame)), amount in [0, 8]
+        static engine::Expected<void> unsharpMask(engine::FrameView frame, double sigma, double amount);
+
+        // GRAY8 edge magnitude min(255, |gx| + |gy|). RGB input is reduced to luma first.
+        static engine::Expected<void> sobel(engine::ConstFrameView src, engine::Frame &dest);
+    };
+}
+
+#endif //ENGINE_FILTERS_H
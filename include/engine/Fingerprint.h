@@ -0,0 +1,77 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_FINGERPRINT_H
+#define ENGINE_FINGERPRINT_H
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Error.h"
+#include "Frame.h"
+#include "Pipeline.h"
+
+namespace engine {
+    // Perceptual hash (pHash) of a frame: luma area-averaged down to 32x32, 2-D DCT, and one bit per
+    // AC coefficient of the 8x8 lowest frequencies, set where it is above their median. Bit 0 (the DC
+    // term, mean brightness) is always clear, leaving 63 significant bits. Survives re-encoding, scaling
+    // and small color changes; similar frames differ in few bits.
+    // RGB24, RGBA32 and GRAY8; any size.
+    engine::Expected<uint64_t> perceptualHash(engine::ConstFrameView frame);
+
+    // Number of differing bits, 0 (same picture) to 64
+    int hammingDistance(uint64_t a, uint64_t b);
+
+    struct FrameHash {
+        double time = 0; // seconds
+        uint64_t hash = 0;
+    };
+
+    // Per-video fingerprint: the hashes of frames sampled through the video, in time order
+    class Signature {
+    public:
+        std::vector<FrameHash> hashes;
+
+        // Mean, over this signature's hashes, of the Hamming distance to the closest hash of other.
+        // Order-insensitive, so trimmed or re-cut copies still match. 64 if either is empty.
+        [[nodiscard]] double distance(const Signature &other) const;
+
+        // Compact binary file: "VPFP", version, count, then 12 bytes per hash (time in ms, hash),
+        // little-endian
+        engine::Expected<void> save(const std::string &path) const;
+
+        static engine::Expected<Signature> load(const std::string &path);
+    };
+
+    // Hashes frames as they pass through a pipeline, one every `interval` seconds, so a video can be
+    // fingerprinted during a decode that runs anyway. Frames are not modified.
+    class FrameHasher final : public Stage {
+    public:
+        // Frame pts to seconds, e.g. [&](int64_t pts) { return decoder.toSeconds(pts); }.
+        // Without one, pts are taken as seconds.
+        using TimeBase = std::function<double(int64_t)>;
+
+        explicit FrameHasher(double interval = 1.0, TimeBase toSeconds = nullptr);
+
+        [[nodiscard]] const char *name() const override { return "FrameHasher"; }
+
+        engine::Expected<bool> process(engine::FrameView frame) override;
+
+        void reset() override;
+
+        [[nodiscard]] const Signature &signature() const { return result; }
+
+    private:
+        double interval;
+        TimeBase toSeconds;
+        double nextTime = 0;
+        Signature result;
+    };
+}
+
+#endif //ENGINE_FINGERPRINT_H
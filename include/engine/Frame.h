@@ -7,11 +7,88 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 #include <vector>
 #include "PixelFormat.h"
 
 namespace engine {
+    struct Frame;
+
+    // Non-owning view of a rectangle inside a frame: points at the rectangle's first pixel and keeps
+    // the parent stride, so a region of interest is processed in place without copying.
+    // Only valid while the parent frame's buffer is.
+    template<typename T>
+    struct BasicFrameView {
+        using FrameRef = std::conditional_t<std::is_const_v<T>, const Frame, Frame>;
+
+        T *data = nullptr; // first pixel of the region
+        int width = 0;
+        int height = 0;
+        int stride = 0; // bytes per row of the parent frame
+        PixelFormat pixelFormat = PixelFormat::UNKNOWN;
+
+        // Offset of the region inside the parent frame
+        int x = 0;
+        int y = 0;
+
+        int64_t pts = 0;
+
+        BasicFrameView() = default;
+
+        BasicFrameView(T *data, const int width, const int height, const int stride, const PixelFormat pixelFormat)
+            : data(data), width(width), height(height), stride(stride), pixelFormat(pixelFormat) {
+        }
+
+        // The whole frame
+        BasicFrameView(FrameRef &frame);
+
+        // FrameView -> ConstFrameView
+        template<typename U> requires (std::is_const_v<T> && !std::is_const_v<U>)
+        BasicFrameView(const BasicFrameView<U> &other)
+            : data(other.data), width(other.width), height(other.height), stride(other.stride),
+              pixelFormat(other.pixelFormat), x(other.x), y(other.y), pts(other.pts) {
+        }
+
+        [[nodiscard]] int bytesPerPixel() const {
+            return engine::bytesPerPixel(pixelFormat);
+        }
+
+        // Bytes of pixel data per row (the stride may be larger)
+        [[nodiscard]] int rowBytes() const {
+            return width * bytesPerPixel();
+        }
+
+        [[nodiscard]] bool empty() const {
+            return width <= 0 || height <= 0;
+        }
+
+        [[nodiscard]] T *row(const int row) const {
+            return data + static_cast<std::ptrdiff_t>(row) * stride;
+        }
+
+        // Sub-rectangle relative to this view, clipped to it (empty if there is no overlap)
+        [[nodiscard]] BasicFrameView sub(const int left, const int top, const int w, const int h) const {
+            const int x0 = std::clamp(left, 0, width);
+            const int y0 = std::clamp(top, 0, height);
+            const int x1 = std::clamp(left + w, x0, width);
+            const int y1 = std::clamp(top + h, y0, height);
+
+            BasicFrameView view(data + static_cast<std::ptrdiff_t>(y0) * stride + x0 * bytesPerPixel(),
+                                x1 - x0, y1 - y0, stride, pixelFormat);
+            view.x = x + x0;
+            view.y = y + y0;
+            view.pts = pts;
+            return view;
+        }
+    };
+
+    using FrameView = BasicFrameView<uint8_t>;
+    using ConstFrameView = BasicFrameView<const uint8_t>;
+
     struct Frame {
         int width = 0;
         int height = 0;
@@ -25,6 +102,7 @@ namespace engine {
 
         // Optional metadata
         int64_t pts = 0; // presentation timestamp
+        int64_t arrival = 0; // utils::nowNanos() when the frame's input data entered the engine, 0 if unknown
 
         Frame() = default;
 
@@ -33,15 +111,18 @@ namespace engine {
             data.resize(stride * height);
         }
 
-        [[nodiscard]] int bytesPerPixel() const {
-            switch (pixelFormat) {
-                case PixelFormat::RGB24: return 3;
-                case PixelFormat::RGBA32: return 4;
-                case PixelFormat::GRAY8: return 1;
-                default: return 0;
+        // Owned copy of a region (crop)
+        explicit Frame(const ConstFrameView &view) : Frame(view.width, view.height, view.pixelFormat) {
+            pts = view.pts;
+            for (int y = 0; y < height; y++) {
+                std::memcpy(row(y), view.row(y), stride);
             }
         }
 
+        [[nodiscard]] int bytesPerPixel() const {
+            return engine::bytesPerPixel(pixelFormat);
+        }
+
         uint8_t *row(const int y) {
             return data.data() + y * stride;
         }
@@ -49,7 +130,30 @@ namespace engine {
         [[nodiscard]] const uint8_t *row(const int y) const {
             return data.data() + y * stride;
         }
+
+        FrameView view() {
+            return FrameView(*this);
+        }
+
+        [[nodiscard]] ConstFrameView view() const {
+            return ConstFrameView(*this);
+        }
+
+        // Region of interest, clipped to the frame
+        FrameView view(const int x, const int y, const int width, const int height) {
+            return view().sub(x, y, width, height);
+        }
+
+        [[nodiscard]] ConstFrameView view(const int x, const int y, const int width, const int height) const {
+            return view().sub(x, y, width, height);
+        }
     };
+
+    template<typename T>
+    BasicFrameView<T>::BasicFrameView(FrameRef &frame)
+        : data(frame.data.data()), width(frame.width), height(frame.height), stride(frame.stride),
+          pixelFormat(frame.pixelFormat), pts(frame.pts) {
+    }
 }
 
 #endif //ENGINE_FRAME_H
@@ -0,0 +1,72 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_FRAMERING_H
+#define ENGINE_FRAMERING_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Error.h"
+#include "Frame.h"
+
+namespace engine {
+    // History of the last N frames of one geometry, stored in a single arena allocated up front.
+    // The arena holds N + 1 slots: the extra one is written while the N older frames are still read,
+    // so a frame can be filtered against its history and stored in the same pass.
+    class FrameRing {
+    public:
+        FrameRing() = default;
+
+        // Throws std::runtime_error on an invalid geometry
+        FrameRing(int historyFrames, int width, int height, PixelFormat pixelFormat);
+
+        // Reallocates only if the geometry changed (history is cleared in that case).
+        // InvalidArgument for an empty frame size, no history or an unknown pixel format.
+        engine::Expected<void> configure(int historyFrames, int width, int height, PixelFormat pixelFormat);
+
+        void clear();
+
+        // Frames available as history (at most historyFrames)
+        [[nodiscard]] int size() const;
+
+        [[nodiscard]] int historyFrames() const { return slots - 1; }
+
+        // age 0 = most recently committed frame
+        [[nodiscard]] const uint8_t *row(int age, int y) const;
+
+        [[nodiscard]] int64_t pts(int age) const;
+
+        // Row of the slot the next frame is written to; it never aliases a history frame
+        uint8_t *writeRow(int y);
+
+        // Makes the write slot the newest history frame; the oldest one becomes the next write slot
+        void commit(int64_t pts);
+
+        [[nodiscard]] bool matches(int width, int height, PixelFormat pixelFormat) const;
+
+        [[nodiscard]] std::size_t bytes() const { return arena.size(); }
+
+    private:
+        [[nodiscard]] const uint8_t *slotData(int slot) const;
+
+        std::vector<uint8_t> arena;
+        std::vector<int64_t> slotPts;
+        std::size_t slotBytes = 0;
+
+        int slots = 0;
+        int head = 0; // write slot
+        int count = 0; // committed frames, saturates at slots
+
+        int width = 0;
+        int height = 0;
+        int stride = 0;
+        PixelFormat pixelFormat = PixelFormat::UNKNOWN;
+    };
+}
+
+#endif //ENGINE_FRAMERING_H
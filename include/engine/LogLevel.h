@@ -0,0 +1,23 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_LOGLEVEL_H
+#define ENGINE_LOGLEVEL_H
+
+#pragma once
+
+#include <cstdint>
+
+namespace engine {
+    // Logger severities, in the order of the ENGINE_LOG_LEVEL compile-time threshold (0 = Info ... 4 = Off)
+    enum class LogLevel : uint8_t {
+        Info = 0,
+        Success = 1,
+        Warn = 2,
+        Error = 3,
+        Off = 4
+    };
+}
+
+#endif //ENGINE_LOGLEVEL_H
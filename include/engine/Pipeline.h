@@ -5,4 +5,121 @@
 #ifndef ENGINE_PIPELINE_H
 #define ENGINE_PIPELINE_H
 
-#endif //ENGINE_PIPELINE_H
\ No newline at end of file
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Config.h"
+#include "Error.h"
+#include "Frame.h"
+
+namespace engine {
+    // One per-frame processing step, given a view of the pipeline's frame. Stages may keep state across frames.
+    class Stage {
+    public:
+        virtual ~Stage() = default;
+
+        [[nodiscard]] virtual const char *name() const = 0;
+
+        // False drops the frame: later stages don't see it. Bad input (e.g. an unsupported pixel format)
+        // is reported as an error, which ends Pipeline::run.
+        virtual engine::Expected<bool> process(engine::FrameView frame) = 0;
+
+        // Forget state carried across frames (new input, seek)
+        virtual void reset() {
+        }
+    };
+
+    // Counters of the last Pipeline::run. Latency is measured from Frame::arrival (the time the input
+    // data came in, or the time the source returned the frame when it doesn't set one) to the sink.
+    struct PipelineStats {
+        std::size_t delivered = 0;
+        std::size_t dropped = 0; // replaced by a newer frame before the stages got to them (low latency)
+
+        double lastLatencyMs = 0; // inside the sink: the frame being delivered
+        double meanLatencyMs = 0;
+        double maxLatencyMs = 0;
+    };
+
+    class Pipeline {
+    public:
+        // Fills the frame with the next input frame, e.g. [&](Frame &f) { return decoder.readFrame_RGB24(f); }.
+        // EndOfStream ends the run, TryAgain (live input without data yet) is retried shortly after, and
+        // any other error is thrown from run() as std::runtime_error.
+        using Source = std::function<engine::Expected<void>(engine::Frame &)>;
+
+        // Receives every frame that made it through the stages
+        using Sink = std::function<void(engine::Frame &)>;
+
+        // Makes a source call that is blocked waiting for input return, e.g. [&] { decoder.interrupt(); }
+        using Interrupt = std::function<void()>;
+
+        // Queue depth and low latency mode from Config::current()
+        Pipeline();
+
+        explicit Pipeline(const engine::Config &config);
+
+        Stage &add(std::unique_ptr<Stage> stage);
+
+        template<typename T, typename... Args>
+        T &emplace(Args &&... args) {
+            auto stage = std::make_unique<T>(std::forward<Args>(args)...);
+            T &ref = *stage;
+            add(std::move(stage));
+            return ref;
+        }
+
+        // Runs the frame through every stage in order. False if a stage dropped it, the first stage error
+        // if one failed (later stages are skipped).
+        engine::Expected<bool> process(engine::Frame &frame);
+
+        void reset();
+
+        [[nodiscard]] std::size_t size() const;
+
+        // Pulls width x height frames of the given format from source until it ends, runs them through
+        // the stages and hands them to sink. With a queue depth > 0 the source runs on its own thread,
+        // up to queueDepth frames ahead; frames come from a fixed pool and are reused, so nothing is
+        // allocated per frame. Returns the number of frames delivered to sink.
+        //
+        // In low latency mode there is no queue: the source keeps reading on its own thread and the stages
+        // always take the newest finished frame. When they fall behind, older frames are dropped instead
+        // of buffered, so latency stays within about two frame intervals plus the stage time.
+        //
+        // A stage error is thrown as std::runtime_error, like a source failure.
+        // When a stage or the sink throws, run() stops the source thread before rethrowing: interrupt is
+        // called and the source is expected to return. Without an interrupt, a source blocked on live
+        // input that has stalled keeps run() waiting until its next frame arrives.
+        std::size_t run(int width, int height, PixelFormat format, const Source &source, const Sink &sink,
+                        const Interrupt &interrupt = nullptr);
+
+        void setLowLatency(bool enabled);
+
+        // Of the current or last run(); read from the sink for per-frame latency
+        [[nodiscard]] const PipelineStats &stats() const;
+
+    private:
+        std::size_t runQueued(int width, int height, PixelFormat format, const Source &source, const Sink &sink,
+                              const Interrupt &interrupt);
+
+        std::size_t runLatest(int width, int height, PixelFormat format, const Source &source, const Sink &sink,
+                              const Interrupt &interrupt);
+
+        // process() for run(): throws on a stage error
+        bool runStages(engine::Frame &frame);
+
+        // Records the frame's latency and hands it to sink
+        void deliver(engine::Frame &frame, const Sink &sink);
+
+        std::vector<std::unique_ptr<Stage> > stages;
+        int queueDepth = 0;
+        bool lowLatency = false;
+        PipelineStats statistics;
+    };
+}
+
+#endif //ENGINE_PIPELINE_H
@@ -14,6 +14,15 @@ namespace engine {
         GRAY8,
         UNKNOWN
     };
+
+    inline int bytesPerPixel(const PixelFormat pixelFormat) {
+        switch (pixelFormat) {
+            case PixelFormat::RGB24: return 3;
+            case PixelFormat::RGBA32: return 4;
+            case PixelFormat::GRAY8: return 1;
+            default: return 0;
+        }
+    }
 }
 
 #endif //ENGINE_PIXELFORMAT_H
@@ -0,0 +1,87 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_SCENEANALYZER_H
+#define ENGINE_SCENEANALYZER_H
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "Error.h"
+#include "Frame.h"
+#include "Pipeline.h"
+
+namespace engine {
+    struct FrameAnalysis {
+        int64_t index = 0; // frames seen since the last reset
+        int64_t pts = 0;
+
+        double meanAbsDiff = 0; // luma SAD against the previous frame / pixel count, 0..255
+        double histogramDistance = 0; // normalized L1 distance of the luma histograms, 0..1
+
+        bool sceneCut = false; // the first frame after a reset always starts a scene
+        bool duplicate = false;
+    };
+
+    struct SceneAnalyzerOptions {
+        // A cut needs both a large histogram change and a large pixel change
+        double cutHistogramDistance = 0.35;
+        double cutMeanAbsDiff = 20.0;
+
+        double duplicateMeanAbsDiff = 0.5;
+
+        // Analyze every n-th row only (1 = full frame)
+        int rowStep = 1;
+
+        // Drop duplicate frames from the pipeline instead of only reporting them
+        bool dropDuplicates = false;
+    };
+
+    // Compares each frame's luma with the previous one and reports scene cuts and duplicates.
+    // GRAY8 frames are used as-is, RGB24/RGBA32 are reduced to luma first.
+    class SceneAnalyzer final : public Stage {
+    public:
+        using Callback = std::function<void(const FrameAnalysis &)>;
+
+        explicit SceneAnalyzer(SceneAnalyzerOptions options = {}, Callback onEvent = nullptr);
+
+        [[nodiscard]] const char *name() const override { return "SceneAnalyzer"; }
+
+        // Calls onEvent for scene cuts and duplicates
+        engine::Expected<bool> process(engine::FrameView frame) override;
+
+        void reset() override;
+
+        // UnsupportedFormat for frames other than GRAY8, RGB24 and RGBA32
+        engine::Expected<FrameAnalysis> analyze(engine::ConstFrameView frame);
+
+        [[nodiscard]] const FrameAnalysis &last() const { return lastResult; }
+
+        // Luma histogram of the last analyzed frame (analyzed rows only)
+        [[nodiscard]] const std::array<uint32_t, 256> &histogram() const { return previousHistogram; }
+
+    private:
+        SceneAnalyzerOptions options;
+        Callback onEvent;
+
+        FrameAnalysis lastResult;
+        int64_t frameIndex = 0;
+
+        int width = 0;
+        int rows = 0;
+        bool hasPrevious = false;
+
+        // Luma of the analyzed rows, swapped every frame so no allocation happens per frame
+        std::vector<uint8_t> currentLuma;
+        std::vector<uint8_t> previousLuma;
+        std::array<uint32_t, 256> currentHistogram{};
+        std::array<uint32_t, 256> previousHistogram{};
+    };
+}
+
+#endif //ENGINE_SCENEANALYZER_H
@@ -0,0 +1,42 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_TEMPORALDENOISER_H
+#define ENGINE_TEMPORALDENOISER_H
+
+#pragma once
+
+#include "Frame.h"
+#include "FrameRing.h"
+#include "Pipeline.h"
+
+namespace engine {
+    struct TemporalDenoiseOptions {
+        // Frames averaged with the current one (1..16)
+        int historyFrames = 4;
+
+        // Per-pixel difference at which a history sample stops contributing (1..255).
+        // Higher values denoise more but smear motion.
+        int threshold = 12;
+    };
+
+    // Motion-adaptive temporal average over a ring of the previous input frames.
+    // The history lives in a FrameRing allocated once, so memory stays flat on long inputs.
+    class TemporalDenoiser final : public Stage {
+    public:
+        explicit TemporalDenoiser(TemporalDenoiseOptions options = {});
+
+        [[nodiscard]] const char *name() const override { return "TemporalDenoiser"; }
+
+        engine::Expected<bool> process(engine::FrameView frame) override;
+
+        void reset() override;
+
+    private:
+        TemporalDenoiseOptions options;
+        FrameRing history;
+    };
+}
+
+#endif //ENGINE_TEMPORALDENOISER_H
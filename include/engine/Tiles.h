@@ -0,0 +1,38 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_TILES_H
+#define ENGINE_TILES_H
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+#include "Error.h"
+#include "Frame.h"
+
+namespace engine {
+    // Splits a view into tileWidth x tileHeight regions (smaller at the right/bottom edge) and calls
+    // fn on each of them in parallel on the shared thread pool. Tiles don't overlap, so fn may write
+    // its own tile freely; keep tiles near the cache size to process 4K/8K frames cache-resident.
+    // Tiles have the view's constness: a Frame gives FrameView tiles (fn may still take ConstFrameView),
+    // a const Frame gives ConstFrameView tiles. InvalidArgument if a tile dimension is not positive.
+    template<typename T>
+    engine::Expected<void> forEachTile(BasicFrameView<T> view, int tileWidth, int tileHeight,
+                                       const std::type_identity_t<std::function<void(BasicFrameView<T>)> > &fn);
+
+    // A Frame doesn't deduce the template above (its view is a conversion), so frames have their own overloads
+    inline engine::Expected<void> forEachTile(engine::Frame &frame, const int tileWidth, const int tileHeight,
+                                              const std::function<void(engine::FrameView)> &fn) {
+        return forEachTile(frame.view(), tileWidth, tileHeight, fn);
+    }
+
+    inline engine::Expected<void> forEachTile(const engine::Frame &frame, const int tileWidth, const int tileHeight,
+                                              const std::function<void(engine::ConstFrameView)> &fn) {
+        return forEachTile(frame.view(), tileWidth, tileHeight, fn);
+    }
+}
+
+#endif //ENGINE_TILES_H
@@ -7,33 +7,105 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <utility>
 
+#include "engine/Config.h"
+#include "engine/Error.h"
 #include "engine/Frame.h"
 #include "libavutil/pixfmt.h"
 
 struct AVFormatContext;
+struct AVIOContext;
 struct AVCodecContext;
 struct AVFrame;
 struct AVPacket;
 struct SwsContext;
 
 namespace engine::io {
+    class FrameCache;
+    class InputSource;
+
     class Decoder {
     public:
+        // Takes scaler, threading and I/O settings from Config::current()
         Decoder();
 
+        explicit Decoder(const engine::Config &config);
+
         ~Decoder();
 
         void open(const std::string &filepath);
 
+        // Decodes from a caller-provided source (memory buffer, callbacks, pipe, upload in progress)
+        // through a custom AVIOContext. The decoder keeps the source alive until close().
+        void open(std::shared_ptr<InputSource> source);
+
+        // Read buffer of the custom AVIOContext, in bytes. Larger buffers mean fewer source reads;
+        // call before open(source).
+        void setIOBufferSize(int bytes);
+
         void close();
 
-        bool readFrame(engine::Frame &outFrame, AVPixelFormat PixelFormat);
+        // Reads return an error code instead of throwing: true if a frame was read, otherwise
+        // error().code is EndOfStream at the end of the file, TryAgain for live input without data yet,
+        // or a failure. Corrupt packets are skipped by default (see setSkipCorruptPackets).
+        engine::Expected<void> readFrame(engine::Frame &outFrame, AVPixelFormat PixelFormat);
+
+        engine::Expected<void> readFrame_RGB24(engine::Frame &outFrame);
+
+        engine::Expected<void> readFrame_RGBA32(engine::Frame &outFrame);
+
+        // Decodes the next frame scaled straight into dest, e.g. a view of one tile of a sprite sheet.
+        // The pts is available from getLastPts().
+        engine::Expected<void> readFrameInto(engine::FrameView dest);
+
+        // Decodes the frame on screen at the given time into outFrame (pixel format and size taken
+        // from outFrame): seeks to the keyframe before it and decodes forward, converting only the frame
+        // asked for. With a frame cache the frame is looked up first, and cached once decoded.
+        engine::Expected<void> readFrameAt(double seconds, engine::Frame &outFrame);
+
+        // readFrameAt() looks frames up in, and stores the frames it decodes into, the given cache
+        // (e.g. &FrameCache::shared()). Sequential readFrame*() calls don't touch it: a linear pass
+        // would only evict the frames worth keeping. nullptr disables caching (the default).
+        void setFrameCache(FrameCache *cache);
+
+        // Live input: minimal probing, no demuxer buffering, AV_CODEC_FLAG_LOW_DELAY and slice threading
+        // (frame threading holds back one frame per thread), so a frame comes out as soon as its packet
+        // arrives. Frames get their arrival time for latency measurement. Call before open().
+        void setLowLatency(bool enabled);
+
+        // Only keyframes are sent to the decoder. Call before open() so threading is set up for it.
+        void setKeyframesOnly(bool enabled);
+
+        // Smallest output size needed; codecs with lowres support decode at reduced size. Call before open().
+        void setDecodeSizeHint(int width, int height);
+
+        // Seeks to the keyframe at or before the given time
+        engine::Expected<void> seek(double seconds);
+
+        // Thread safe: makes a read that is blocked waiting for input return, and later reads fail, until
+        // the next open(). Custom inputs are interrupted through InputSource::interrupt(). For
+        // Pipeline::run's interrupt hook.
+        void interrupt();
 
-        // True if a Frame was read from video | False if end of File
-        bool readFrame_RGB24(engine::Frame &outFrame); // True if a Frame was read from video | False if end of File
-        bool readFrame_RGBA32(engine::Frame &outFrame); // True if a Frame was read from video | False if end of File
+        // Skip packets the demuxer can't parse or the codec rejects, and frames the codec flags as corrupt
+        // (concealed errors), and keep decoding (default); or stop and return CorruptData
+        void setSkipCorruptPackets(bool enabled);
+
+        // Corrupt packets and frames skipped since open()
+        [[nodiscard]] uint64_t getCorruptPackets() const;
+
+        [[nodiscard]] int64_t getLastPts() const;
+
+        // Stream pts to seconds since the start of the video stream (-1 if unknown)
+        [[nodiscard]] double toSeconds(int64_t pts) const;
+
+        // Container duration in seconds (-1 if unknown)
+        [[nodiscard]] double getDuration() const;
 
         [[nodiscard]] int getWidth() const;
 
@@ -44,6 +116,23 @@ namespace engine::io {
         static void printVideoInfo(const std::string &filepath);
 
     private:
+        // Everything after the input is opened: stream probing, codec setup
+        void openStreams();
+
+        // Leaves the next decoded frame in avFrame
+        engine::Expected<void> decodeNext();
+
+        // Scales the frame in avFrame into outFrame and sets its pts and arrival time
+        engine::Expected<void> convertDecoded(engine::Frame &outFrame, AVPixelFormat PixelFormat);
+
+        // Seconds since the start of the video stream to stream pts
+        [[nodiscard]] int64_t toPts(double seconds) const;
+
+        // Arrival time of the packet with the given pts, now if it isn't tracked (any more)
+        [[nodiscard]] int64_t arrivalOf(int64_t pts) const;
+
+        engine::Expected<void> scaleInto(uint8_t *dest, int destStride, int destWidth, int destHeight, AVPixelFormat PixelFormat);
+
         AVFormatContext *formatCtx = nullptr; // The File
         AVCodecContext *codecCtx = nullptr; // The Codec (H.264, etc.)
         AVFrame *avFrame = nullptr; // The Raw Frame (YUV format)
@@ -51,8 +140,39 @@ namespace engine::io {
 
         SwsContext *swsCtx = nullptr;
 
+        // Custom input (open(source) only)
+        std::shared_ptr<InputSource> inputSource;
+        AVIOContext *ioCtx = nullptr;
+        int ioBufferSize = 64 * 1024;
+
+        int scaleFlags = 0; // SWS_* algorithm
+        int decoderThreads = 0;
+
         int videoStreamIndex = -1;
         double fps = -1;
+
+        bool draining = false; // end of file reached, decoder is being flushed
+        bool keyframesOnly = false;
+        bool lowLatency = false;
+        bool skipCorrupt = true;
+        uint64_t corruptPackets = 0;
+        int hintWidth = 0;
+        int hintHeight = 0;
+        int64_t lastPts = 0;
+
+        // Polled by FFmpeg's interrupt callback while it waits for input
+        std::atomic<bool> interrupted = false;
+
+        FrameCache *frameCache = nullptr;
+        std::string sourcePath;
+        std::string sourceIdentity; // FrameCache::fileIdentity() of sourcePath, or InputSource::identity()
+        int64_t frameDuration = 1; // in stream time base units, from the average frame rate
+
+        // utils::nowNanos() when each recently read video packet came in, by pts. A few entries cover
+        // the packets a low-delay decoder holds at once.
+        static constexpr int kArrivals = 16;
+        std::array<std::pair<int64_t, int64_t>, kArrivals> arrivals{};
+        int nextArrival = 0;
     };
 }
 
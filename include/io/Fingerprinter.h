@@ -0,0 +1,32 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_FINGERPRINTER_H
+#define ENGINE_FINGERPRINTER_H
+
+#pragma once
+
+#include <string>
+
+#include "engine/Fingerprint.h"
+
+namespace engine::io {
+    struct FingerprintOptions {
+        // Seconds between sampled frames; each sample is the first keyframe at or after its time
+        double interval = 1.0;
+
+        int maxFrames = 0; // 0 = no limit
+    };
+
+    // Fingerprints a video file by decoding keyframes only, at reduced size. For videos that are
+    // decoded anyway, engine::FrameHasher gets the same signature without a second decode.
+    class Fingerprinter {
+    public:
+        // InvalidArgument for a non-positive interval or negative maxFrames. Throws std::runtime_error
+        // if the file can't be opened, like Decoder::open.
+        static engine::Expected<engine::Signature> fingerprint(const std::string &filepath, const FingerprintOptions &options = {});
+    };
+}
+
+#endif //ENGINE_FINGERPRINTER_H
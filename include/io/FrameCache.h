@@ -0,0 +1,139 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_FRAMECACHE_H
+#define ENGINE_FRAMECACHE_H
+
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "engine/Frame.h"
+
+namespace engine::io {
+    struct FrameKey {
+        std::string source; // FrameCache::fileIdentity() of the input, or its InputSource::identity()
+        PixelFormat format = PixelFormat::UNKNOWN;
+        int width = 0;
+        int height = 0;
+        int64_t pts = 0;
+
+        auto operator<=>(const FrameKey &) const = default;
+    };
+
+    struct FrameCacheOptions {
+        std::size_t memoryBudget = std::size_t{512} << 20;
+
+        // Frames evicted from memory are spilled to this directory as raw files. A hit reads the file
+        // back with plain reads into a new frame (they are not memory-mapped) and promotes it to memory.
+        // The files are picked up again by later runs. Empty = memory only.
+        std::string diskDirectory;
+        std::size_t diskBudget = std::size_t{4} << 30;
+    };
+
+    struct FrameCacheStats {
+        uint64_t hits = 0;
+        uint64_t diskHits = 0; // included in hits
+        uint64_t misses = 0;
+
+        std::size_t frames = 0;
+        std::size_t memoryBytes = 0;
+        std::size_t diskBytes = 0;
+    };
+
+    // LRU cache of decoded, converted frames, shared by every Decoder that is given it.
+    // Thread safe. Frames are handed out as shared immutable buffers, so a memory hit costs no decode
+    // and no copy inside the cache. Disk reads and writes run outside the cache lock.
+    class FrameCache {
+    public:
+        explicit FrameCache(FrameCacheOptions options = {});
+
+        FrameCache(const FrameCache &) = delete;
+
+        FrameCache &operator=(const FrameCache &) = delete;
+
+        // Process-wide instance (memory only until configured)
+        static FrameCache &shared();
+
+        // New budgets apply immediately; a new disk directory is scanned for frames of earlier runs
+        void configure(const FrameCacheOptions &newOptions);
+
+        // Path, size and modification time, so a file that changes on disk gets new keys
+        static std::string fileIdentity(const std::string &path);
+
+        // duration: how long the frame is shown, in stream time base units
+        void insert(const FrameKey &key, int64_t duration, engine::Frame frame);
+
+        // The cached frame on screen at key.pts (frame pts <= key.pts < frame pts + duration), null on a miss
+        std::shared_ptr<const engine::Frame> find(const FrameKey &key);
+
+        // Drops every frame, including the files of the disk tier
+        void clear();
+
+        [[nodiscard]] FrameCacheStats stats() const;
+
+    private:
+        struct Entry {
+            int64_t duration = 1;
+
+            std::shared_ptr<const engine::Frame> frame; // memory tier, null when only on disk
+            std::size_t bytes = 0;
+            std::list<const FrameKey *>::iterator memoryPosition;
+
+            bool onDisk = false;
+            std::size_t diskBytes = 0;
+            std::list<const FrameKey *>::iterator diskPosition;
+            uint64_t diskGeneration = 0; // tells a file read without the lock from its replacement
+        };
+
+        using EntryMap = std::map<FrameKey, Entry>;
+
+        // A frame evicted from memory that still has to be written to the disk tier
+        struct Spill {
+            FrameKey key;
+            int64_t duration = 1;
+            std::shared_ptr<const engine::Frame> frame;
+            std::string path;
+            std::size_t bytes = 0; // file size once written, 0 if writing failed
+        };
+
+        // Under the lock: drops frames over the budgets and returns those to spill
+        std::vector<Spill> evict();
+
+        // Without the lock: writes the spilled frames, then publishes them to the disk tier
+        void store(std::vector<Spill> &spills);
+
+        void removeFile(const FrameKey &key, Entry &entry);
+
+        // Removes the file, and the entry too unless it is also in memory
+        void dropFromDisk(EntryMap::iterator it);
+
+        static std::size_t writeFile(const Spill &spill);
+
+        static std::shared_ptr<const engine::Frame> readFile(const std::string &path, const FrameKey &key);
+
+        void scanDisk();
+
+        [[nodiscard]] std::string diskPath(const FrameKey &key) const;
+
+        FrameCacheOptions options;
+
+        mutable std::mutex mutex;
+        EntryMap entries;
+        std::list<const FrameKey *> memoryLru; // most recently used first
+        std::list<const FrameKey *> diskLru;
+        FrameCacheStats counters;
+        uint64_t diskGenerations = 0;
+    };
+}
+
+#endif //ENGINE_FRAMECACHE_H
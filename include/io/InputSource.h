@@ -0,0 +1,122 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_INPUTSOURCE_H
+#define ENGINE_INPUTSOURCE_H
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace engine::io {
+    // Byte stream a Decoder can read instead of a file path (memory, callbacks, pipes, uploads).
+    // The Decoder wraps it in a custom AVIOContext; reads happen on the decoding thread.
+    class InputSource {
+    public:
+        InputSource();
+
+        using ReadCallback = std::function<int(uint8_t *buffer, int size)>;
+        using SeekCallback = std::function<int64_t(int64_t offset, int whence)>;
+
+        virtual ~InputSource() = default;
+
+        // Up to size bytes into buffer. Returns the byte count, 0 at the end of the stream, < 0 on error.
+        virtual int read(uint8_t *buffer, int size) = 0;
+
+        // Containers with the index at the end (MP4 without faststart) need a seekable source,
+        // as does Decoder::seek()
+        [[nodiscard]] virtual bool seekable() const { return false; }
+
+        // whence is SEEK_SET, SEEK_CUR or SEEK_END. Returns the new position, < 0 on error.
+        virtual int64_t seek(int64_t offset, int whence);
+
+        // Total size in bytes, -1 if unknown
+        [[nodiscard]] virtual int64_t size() const { return -1; }
+
+        // Thread safe: makes a read() that is blocked waiting for data return an error, and later reads
+        // fail. Called by Decoder::interrupt(). Sources whose reads never block indefinitely ignore it;
+        // callback sources have to return from their read callback on their own.
+        virtual void interrupt() {
+        }
+
+        // Shown in logs and passed to the demuxer as a probing hint
+        [[nodiscard]] virtual std::string name() const = 0;
+
+        // Frame cache identity. Unique to this instance by default (names such as "memory" are shared by
+        // unrelated inputs), so cached frames only ever match the source they were decoded from.
+        // Sources backed by a file return its FrameCache::fileIdentity(), as opening the path does.
+        [[nodiscard]] virtual std::string identity() const;
+
+        // Caller-owned memory, which must stay valid while the decoder uses it
+        static std::shared_ptr<InputSource> fromMemory(const uint8_t *data, std::size_t size,
+                                                       std::string name = "memory");
+
+        // Takes ownership of the buffer
+        static std::shared_ptr<InputSource> fromBuffer(std::vector<uint8_t> data, std::string name = "memory");
+
+        // read follows InputSource::read; without a seek callback the source is not seekable
+        static std::shared_ptr<InputSource> fromCallbacks(ReadCallback read, SeekCallback seek = nullptr,
+                                                          std::string name = "callback");
+
+        // Sequential reads from a pipe or any other stdio stream (e.g. stdin), which is not closed. Reads go
+        // to its file descriptor and return as soon as any data is there, so nothing may have been read
+        // from the stream through stdio before. Interruptible except on Windows.
+        static std::shared_ptr<InputSource> fromPipe(std::FILE *stream, std::string name = "pipe");
+
+        // Local file read through a memory mapping instead of read() calls. Null if it can't be mapped.
+        static std::shared_ptr<InputSource> mapFile(const std::string &path);
+
+    private:
+        uint64_t serial; // per-process instance number, part of identity()
+    };
+
+    // Input that arrives while decoding runs, e.g. an upload: the producer append()s chunks and the
+    // decoder's reads block until enough data is there or finish() is called. Everything received is
+    // kept, so the demuxer can seek back; seeking relative to the end waits for finish().
+    class StreamingSource final : public InputSource {
+    public:
+        explicit StreamingSource(std::string name = "stream");
+
+        void append(const uint8_t *data, std::size_t size);
+
+        // No more data: reads past the end return end of stream
+        void finish();
+
+        // Aborts the stream: pending and later reads fail
+        void fail();
+
+        // Same as fail()
+        void interrupt() override { fail(); }
+
+        int read(uint8_t *buffer, int size) override;
+
+        [[nodiscard]] bool seekable() const override { return true; }
+
+        int64_t seek(int64_t offset, int whence) override;
+
+        [[nodiscard]] int64_t size() const override;
+
+        [[nodiscard]] std::string name() const override { return label; }
+
+    private:
+        std::string label;
+
+        mutable std::mutex mutex;
+        std::condition_variable arrived;
+        std::vector<uint8_t> data;
+        std::size_t position = 0;
+        bool finished = false;
+        bool failed = false;
+    };
+}
+
+#endif //ENGINE_INPUTSOURCE_H
@@ -0,0 +1,49 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_MAPPEDFILE_H
+#define ENGINE_MAPPEDFILE_H
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace engine::io {
+    // Read-only memory mapping of a whole file. The pages are loaded by the OS on first access,
+    // so reading a mapped file costs no read() calls and no intermediate buffer.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        MappedFile(MappedFile &&other) noexcept;
+
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        // False if the file can't be opened or mapped (an empty file maps to size 0)
+        bool open(const std::string &path);
+
+        void close();
+
+        [[nodiscard]] bool isOpen() const { return opened; }
+
+        [[nodiscard]] const uint8_t *data() const { return mapping; }
+
+        [[nodiscard]] std::size_t size() const { return length; }
+
+    private:
+        const uint8_t *mapping = nullptr;
+        std::size_t length = 0;
+        bool opened = false;
+    };
+}
+
+#endif //ENGINE_MAPPEDFILE_H
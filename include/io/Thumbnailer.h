@@ -0,0 +1,51 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_THUMBNAILER_H
+#define ENGINE_THUMBNAILER_H
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "engine/Error.h"
+#include "engine/Frame.h"
+
+namespace engine::io {
+    struct SpriteSheetOptions {
+        int columns = 10;
+        int rows = 10; // at most columns * rows thumbnails
+
+        int tileWidth = 160;
+        int tileHeight = 0; // 0 = follow the video aspect ratio
+
+        // Seconds between thumbnails, 0 = spread evenly over the duration
+        double interval = 0;
+
+        PixelFormat pixelFormat = PixelFormat::RGB24;
+    };
+
+    struct SpriteSheet {
+        engine::Frame sheet;
+
+        int tileWidth = 0;
+        int tileHeight = 0;
+        int columns = 0;
+
+        // Time in seconds of every tile, in row-major tile order
+        std::vector<double> timestamps;
+    };
+
+    // Builds preview sprite sheets by decoding keyframes only, scaled directly into their tile
+    class Thumbnailer {
+    public:
+        // InvalidArgument for an empty layout, UnsupportedFormat for an unknown pixel format. Throws
+        // std::runtime_error if the file can't be opened, like Decoder::open.
+        static engine::Expected<SpriteSheet> createSpriteSheet(const std::string &filepath, const SpriteSheetOptions &options = {});
+    };
+}
+
+#endif //ENGINE_THUMBNAILER_H
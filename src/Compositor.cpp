@@ -0,0 +1,140 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+
+#include "engine/Compositor.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        // Transparent gaps shorter than this are blended anyway (a no-op) to keep spans SIMD-sized
+        constexpr int kMinGap = 16;
+    }
+
+    engine::Expected<bool> Compositor::process(const engine::FrameView frame) {
+        if (const auto drawn = composite(frame); !drawn) {
+            return drawn.error();
+        }
+        return true;
+    }
+
+    engine::Expected<int> Compositor::addOverlay(const engine::ConstFrameView overlay, const int x, const int y) {
+        Layer layer;
+        layer.x = x;
+        layer.y = y;
+        if (const auto prepared = prepare(layer, overlay); !prepared) {
+            return prepared.error();
+        }
+        layer.id = nextId++;
+        layers.push_back(std::move(layer));
+        return layers.back().id;
+    }
+
+    engine::Expected<void> Compositor::updateOverlay(const int id, const engine::ConstFrameView overlay) {
+        Layer *layer = find(id);
+        if (!layer) {
+            logger::error("Compositor::updateOverlay: no overlay with id {}", id);
+            return Error{ErrorCode::InvalidArgument, "Compositor::updateOverlay: unknown overlay id"};
+        }
+        return prepare(*layer, overlay);
+    }
+
+    engine::Expected<void> Compositor::moveOverlay(const int id, const int x, const int y) {
+        Layer *layer = find(id);
+        if (!layer) {
+            logger::error("Compositor::moveOverlay: no overlay with id {}", id);
+            return Error{ErrorCode::InvalidArgument, "Compositor::moveOverlay: unknown overlay id"};
+        }
+        layer->x = x;
+        layer->y = y;
+        return {};
+    }
+
+    engine::Expected<void> Compositor::setVisible(const int id, const bool visible) {
+        Layer *layer = find(id);
+        if (!layer) {
+            logger::error("Compositor::setVisible: no overlay with id {}", id);
+            return Error{ErrorCode::InvalidArgument, "Compositor::setVisible: unknown overlay id"};
+        }
+        layer->visible = visible;
+        return {};
+    }
+
+    engine::Expected<void> Compositor::removeOverlay(const int id) {
+        const Layer *layer = find(id);
+        if (!layer) {
+            logger::error("Compositor::removeOverlay: no overlay with id {}", id);
+            return Error{ErrorCode::InvalidArgument, "Compositor::removeOverlay: unknown overlay id"};
+        }
+        layers.erase(layers.begin() + (layer - layers.data()));
+        return {};
+    }
+
+    void Compositor::clear() {
+        layers.clear();
+    }
+
+    engine::Expected<void> Compositor::composite(const engine::FrameView base) const {
+        if (base.pixelFormat != PixelFormat::RGB24 && base.pixelFormat != PixelFormat::RGBA32) {
+            logger::error("Compositor::composite: frame must be in RGB24 or RGBA32 format");
+            return Error{ErrorCode::UnsupportedFormat, "Compositor::composite: frame must be in RGB24 or RGBA32 format"};
+        }
+
+        Backend &backend = Backend::active();
+        for (const Layer &layer: layers) {
+            if (!layer.visible || layer.runs.spans.empty()) continue;
+            backend.blend(layer.premultiplied, base, layer.x, layer.y, &layer.runs);
+        }
+        return {};
+    }
+
+    Compositor::Layer *Compositor::find(const int id) {
+        const auto it = std::find_if(layers.begin(), layers.end(), [id](const Layer &layer) {
+            return layer.id == id;
+        });
+        return it == layers.end() ? nullptr : &*it;
+    }
+
+    engine::Expected<void> Compositor::prepare(Layer &layer, const engine::ConstFrameView overlay) {
+        if (overlay.pixelFormat != PixelFormat::RGBA32) {
+            logger::error("Compositor: overlay must be in RGBA32 format");
+            return Error{ErrorCode::UnsupportedFormat, "Compositor: overlay must be in RGBA32 format"};
+        }
+
+        engine::Frame &premultiplied = layer.premultiplied;
+        if (premultiplied.width != overlay.width || premultiplied.height != overlay.height) {
+            premultiplied = engine::Frame(overlay.width, overlay.height, PixelFormat::RGBA32);
+        }
+        Backend::active().premultiply(overlay, premultiplied);
+
+        std::vector<OverlaySpans::Span> &spans = layer.runs.spans;
+        std::vector<int> &rowSpans = layer.runs.rowSpans;
+        spans.clear();
+        rowSpans.assign(1, 0);
+
+        for (int y = 0; y < overlay.height; y++) {
+            const uint8_t *row = overlay.row(y);
+
+            for (int x = 0; x < overlay.width;) {
+                while (x < overlay.width && row[x * 4 + 3] == 0) x++;
+                if (x == overlay.width) break;
+                const int begin = x;
+                while (x < overlay.width && row[x * 4 + 3] != 0) x++;
+
+                const bool extend = static_cast<int>(spans.size()) > rowSpans.back() &&
+                                    begin - spans.back().end < kMinGap;
+                if (extend) {
+                    spans.back().end = x;
+                } else {
+                    spans.push_back({begin, x});
+                }
+            }
+            rowSpans.push_back(static_cast<int>(spans.size()));
+        }
+        return {};
+    }
+}
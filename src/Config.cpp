@@ -0,0 +1,236 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include "engine/Config.h"
+#include "engine/Backend.h"
+#include "backend/cpu/Simd.h"
+#include "io/FrameCache.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        constexpr const char *kKeys[] = {
+            "scaler", "decoder_threads", "io_buffer_size", "low_latency", "worker_threads", "queue_depth", "backend",
+            "simd", "frame_cache_memory", "frame_cache_dir", "frame_cache_disk", "log_level"
+        };
+
+        std::mutex currentMutex;
+        Config currentConfig;
+
+        std::string trim(const std::string_view text) {
+            const auto begin = text.find_first_not_of(" \t\r\n");
+            if (begin == std::string_view::npos) return {};
+            const auto end = text.find_last_not_of(" \t\r\n");
+            return std::string(text.substr(begin, end - begin + 1));
+        }
+
+        std::string lower(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(),
+                           [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            return text;
+        }
+
+        [[noreturn]] void invalid(const std::string &key, const std::string &value) {
+            logger::error("Config: invalid value '{}' for {}", value, key);
+            throw std::runtime_error("Config: invalid value '" + value + "' for " + key);
+        }
+
+        // Whole string as a non-negative number, with an optional K/M/G (1024-based) suffix for sizes
+        unsigned long long parseNumber(const std::string &key, const std::string &value, const bool allowSuffix) {
+            std::size_t used = 0;
+            unsigned long long number = 0;
+            try {
+                if (!value.empty() && value[0] == '-') invalid(key, value);
+                number = std::stoull(value, &used);
+            } catch (const std::logic_error &) {
+                invalid(key, value);
+            }
+
+            const std::string suffix = lower(value.substr(used));
+            if (suffix.empty()) return number;
+            if (allowSuffix && suffix.size() == 1) {
+                switch (suffix[0]) {
+                    case 'k': return number << 10;
+                    case 'm': return number << 20;
+                    case 'g': return number << 30;
+                    default: break;
+                }
+            }
+            invalid(key, value);
+        }
+
+        bool parseBool(const std::string &key, const std::string &value) {
+            const std::string word = lower(value);
+            if (word == "1" || word == "true" || word == "on" || word == "yes") return true;
+            if (word == "0" || word == "false" || word == "off" || word == "no") return false;
+            invalid(key, value);
+        }
+
+        int parseCount(const std::string &key, const std::string &value, const int max) {
+            const unsigned long long number = parseNumber(key, value, false);
+            if (number > static_cast<unsigned long long>(max)) invalid(key, value);
+            return static_cast<int>(number);
+        }
+    }
+
+    void Config::set(const std::string &key, const std::string &value) {
+        const std::string word = lower(value);
+
+        if (key == "scaler") {
+            if (word == "fast_bilinear") scaler = ScalerAlgorithm::FastBilinear;
+            else if (word == "bilinear") scaler = ScalerAlgorithm::Bilinear;
+            else if (word == "bicubic") scaler = ScalerAlgorithm::Bicubic;
+            else if (word == "area") scaler = ScalerAlgorithm::Area;
+            else if (word == "point") scaler = ScalerAlgorithm::Point;
+            else if (word == "lanczos") scaler = ScalerAlgorithm::Lanczos;
+            else invalid(key, value);
+        } else if (key == "decoder_threads") {
+            decoderThreads = parseCount(key, value, 256);
+        } else if (key == "io_buffer_size") {
+            const unsigned long long size = parseNumber(key, value, true);
+            if (size < 4096 || size > (1u << 30)) invalid(key, value);
+            ioBufferSize = static_cast<int>(size);
+        } else if (key == "low_latency") {
+            lowLatency = parseBool(key, value);
+        } else if (key == "worker_threads") {
+            workerThreads = parseCount(key, value, 1024);
+        } else if (key == "queue_depth") {
+            queueDepth = parseCount(key, value, 1024);
+        } else if (key == "backend") {
+            backend = value;
+        } else if (key == "simd") {
+            if (word == "auto") simd = SimdOverride::Auto;
+            else if (word == "scalar") simd = SimdOverride::Scalar;
+            else if (word == "avx2") simd = SimdOverride::AVX2;
+            else invalid(key, value);
+        } else if (key == "frame_cache_memory") {
+            frameCacheMemory = parseNumber(key, value, true);
+        } else if (key == "frame_cache_dir") {
+            frameCacheDir = value;
+        } else if (key == "frame_cache_disk") {
+            frameCacheDisk = parseNumber(key, value, true);
+        } else if (key == "log_level") {
+            if (word == "info") logLevel = LogLevel::Info;
+            else if (word == "success") logLevel = LogLevel::Success;
+            else if (word == "warn") logLevel = LogLevel::Warn;
+            else if (word == "error") logLevel = LogLevel::Error;
+            else if (word == "off") logLevel = LogLevel::Off;
+            else invalid(key, value);
+        } else {
+            logger::error("Config: unknown key {}", key);
+            throw std::runtime_error("Config: unknown key " + key);
+        }
+    }
+
+    Config Config::fromFile(const std::string &path) {
+        std::ifstream file(path);
+        if (!file) {
+            logger::error("Config::fromFile: could not open {}", path);
+            throw std::runtime_error("Config::fromFile: could not open " + path);
+        }
+
+        Config config;
+        std::string line;
+        for (int number = 1; std::getline(file, line); number++) {
+            const std::string content = trim(std::string_view(line).substr(0, line.find('#')));
+            if (content.empty()) continue;
+
+            const auto equals = content.find('=');
+            if (equals == std::string::npos) {
+                logger::error("Config::fromFile: {}:{}: expected key = value", path, number);
+                throw std::runtime_error("Config::fromFile: syntax error in " + path);
+            }
+            config.set(lower(trim(std::string_view(content).substr(0, equals))),
+                       trim(std::string_view(content).substr(equals + 1)));
+        }
+        return config;
+    }
+
+    Config Config::fromEnvironment(Config base) {
+        for (const char *key: kKeys) {
+            std::string name = "ENGINE_";
+            for (const char *c = key; *c; c++) {
+                name += static_cast<char>(std::toupper(static_cast<unsigned char>(*c)));
+            }
+            if (const char *value = std::getenv(name.c_str()); value && *value) {
+                base.set(key, trim(value));
+            }
+        }
+        return base;
+    }
+
+    Config Config::fromEnvironment() {
+        return fromEnvironment(Config{});
+    }
+
+    Config Config::load(const std::string &path) {
+        return fromEnvironment(path.empty() ? Config{} : fromFile(path));
+    }
+
+    void Config::apply() const {
+        // Everything that can fail is checked first, so a rejected configuration changes nothing
+        const char *forced = std::getenv("ENGINE_BACKEND");
+        const std::string backendName = !backend.empty() ? backend : forced ? forced : "";
+        if (!backendName.empty()) {
+            const auto chosen = Backend::find(backendName);
+            if (!chosen || !chosen->isAvailable()) {
+                logger::error("Config::apply: backend {} is unknown or not available on this machine", backendName);
+                throw std::runtime_error("Config::apply: backend not available: " + backendName);
+            }
+        }
+        if (simd == SimdOverride::AVX2 && cpu::detectSimdLevel() < cpu::SimdLevel::AVX2) {
+            logger::error("Config::apply: simd = avx2, but this CPU doesn't support AVX2");
+            throw std::runtime_error("Config::apply: simd = avx2, but this CPU doesn't support AVX2");
+        }
+
+        // Last check, as a successful resize is already applied
+        auto &pool = utils::ThreadPool::shared();
+        const std::size_t workers = workerThreads > 0
+                                        ? static_cast<std::size_t>(workerThreads)
+                                        : std::max(1u, std::thread::hardware_concurrency()) - 1;
+        if (pool.concurrency() != workers + 1 && !pool.resize(workers)) {
+            logger::error("Config::apply: worker_threads can't change while the thread pool is running work");
+            throw std::runtime_error("Config::apply: worker_threads can't change while the thread pool is running work");
+        }
+
+        logger::setLevel(logLevel);
+
+        // Activating a backend sets its SIMD level, so the override goes last. Re-activating it every time
+        // puts unset keys back to automatic selection after an earlier apply() overrode them.
+        if (!backend.empty()) {
+            Backend::select(backend);
+        } else {
+            Backend::selectDefault();
+        }
+        if (simd != SimdOverride::Auto) {
+            cpu::setSimdLevel(simd == SimdOverride::AVX2 ? cpu::SimdLevel::AVX2 : cpu::SimdLevel::Scalar);
+        }
+
+        io::FrameCacheOptions cacheOptions;
+        cacheOptions.memoryBudget = frameCacheMemory;
+        cacheOptions.diskDirectory = frameCacheDir;
+        cacheOptions.diskBudget = frameCacheDisk;
+        io::FrameCache::shared().configure(cacheOptions);
+
+        std::lock_guard<std::mutex> lock(currentMutex);
+        currentConfig = *this;
+    }
+
+    Config Config::current() {
+        std::lock_guard<std::mutex> lock(currentMutex);
+        return currentConfig;
+    }
+}
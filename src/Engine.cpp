@@ -3,9 +3,11 @@
 //
 
 #include <fstream>
-#include <stdexcept>
+#include <vector>
 
 #include "engine/Engine.h"
+#include "backend/cpu/Kernels.h"
+#include "engine/Backend.h"
 #include "engine/Frame.h"
 #include "libavformat/avformat.h"
 #include "utils/Logger.h"
@@ -16,16 +18,20 @@ namespace engine {
     void Engine::process(const std::string &input, const std::string &output) {
     }
 
-    void Engine::savePPM(const engine::Frame &frame, const std::string &output) {
+    void Engine::configure(const engine::Config &config) {
+        config.apply();
+    }
+
+    engine::Expected<void> Engine::savePPM(const engine::ConstFrameView &frame, const std::string &output) {
         if (frame.pixelFormat != engine::PixelFormat::RGB24) {
             logger::error("savePPM: PPM is only for RGB24");
-            throw std::runtime_error("savePPM: PPM is only for RGB24");
+            return Error{ErrorCode::UnsupportedFormat, "savePPM: PPM is only for RGB24"};
         }
 
         std::ofstream file(output, std::ios::binary);
         if (!file) {
             logger::error("savePPM: could not open file for writing: {}", output);
-            throw std::runtime_error("savePPM: could not open file for writing");
+            return Error{ErrorCode::IOFailure, "savePPM: could not open file for writing"};
         }
 
         file << "P6\n";
@@ -34,20 +40,26 @@ namespace engine {
 
         for (int y = 0; y < frame.height; y++) {
             const uint8_t *row = frame.row(y);
-            file.write(reinterpret_cast<const char *>(row), frame.stride);
+            file.write(reinterpret_cast<const char *>(row), frame.rowBytes());
+        }
+
+        if (!file.flush()) {
+            logger::error("savePPM: write failed: {}", output);
+            return Error{ErrorCode::IOFailure, "savePPM: write failed"};
         }
+        return {};
     }
 
-    void Engine::savePAM(const engine::Frame &frame, const std::string &output) {
+    engine::Expected<void> Engine::savePAM(const engine::ConstFrameView &frame, const std::string &output) {
         if (frame.pixelFormat != engine::PixelFormat::RGBA32) {
             logger::error("savePAM: PAM is only for RGBA32");
-            throw std::runtime_error("savePAM: PAM is only for RGBA32");
+            return Error{ErrorCode::UnsupportedFormat, "savePAM: PAM is only for RGBA32"};
         }
 
         std::ofstream file(output, std::ios::binary);
         if (!file) {
             logger::error("savePAM: could not open file for writing: {}", output);
-            throw std::runtime_error("savePAM: could not open file for writing");
+            return Error{ErrorCode::IOFailure, "savePAM: could not open file for writing"};
         }
 
         file << "P7\n";
@@ -60,15 +72,21 @@ namespace engine {
 
         for (int y = 0; y < frame.height; y++) {
             const uint8_t *row = frame.row(y);
-            file.write(reinterpret_cast<const char *>(row), frame.stride);
+            file.write(reinterpret_cast<const char *>(row), frame.rowBytes());
+        }
+
+        if (!file.flush()) {
+            logger::error("savePAM: write failed: {}", output);
+            return Error{ErrorCode::IOFailure, "savePAM: write failed"};
         }
+        return {};
     }
 
-    void Engine::savePGM(const engine::Frame &frame, const std::string &output) {
+    engine::Expected<void> Engine::savePGM(const engine::ConstFrameView &frame, const std::string &output) {
         std::ofstream file(output, std::ios::binary);
         if (!file) {
             logger::error("savePGM: could not open file for writing: {}", output);
-            throw std::runtime_error("savePGM: could not open file for writing");
+            return Error{ErrorCode::IOFailure, "savePGM: could not open file for writing"};
         }
 
         file << "P5\n";
@@ -85,83 +103,92 @@ namespace engine {
             // Convert to grayscale on-the-fly and write only the luminance
             logger::warn("savePGM: Converting frame to grayscale for PGM output");
             const int bytesPerPixel = frame.bytesPerPixel();
+            std::vector<uint8_t> luma(frame.width);
             for (int y = 0; y < frame.height; y++) {
-                const uint8_t *row = frame.row(y);
-                for (int x = 0; x < frame.width; x++) {
-                    const int i = x * bytesPerPixel;
-                    const uint8_t r = row[i + 0];
-                    const uint8_t g = row[i + 1];
-                    const uint8_t b = row[i + 2];
-                    const auto gray = static_cast<uint8_t>(0.299 * r + 0.587 * g + 0.114 * b);
-                    file.write(reinterpret_cast<const char *>(&gray), 1);
-                }
+                // Same fixed-point luma as toGrayScale, so both routes save identical files
+                cpu::lumaFromRGB(frame.row(y), bytesPerPixel, luma.data(), frame.width);
+                file.write(reinterpret_cast<const char *>(luma.data()), frame.width);
             }
         }
+
+        if (!file.flush()) {
+            logger::error("savePGM: write failed: {}", output);
+            return Error{ErrorCode::IOFailure, "savePGM: write failed"};
+        }
+        return {};
     }
 
-    void Engine::toGrayScale(engine::Frame &frame) {
+    engine::Expected<void> Engine::toGrayScale(const engine::FrameView frame) {
         if (frame.pixelFormat == engine::PixelFormat::GRAY8) {
             logger::warn("toGrayScale: frame is already GRAY8");
-            return;
+            return {};
         }
 
-        const int bytesPerPixel = frame.bytesPerPixel();
-
-        for (int y = 0; y < frame.height; y++) {
-            uint8_t *row = frame.row(y);
-            for (int x = 0; x < frame.width; x++) {
-                const int i = x * bytesPerPixel;
-
-                const uint8_t r = row[i + 0];
-                const uint8_t g = row[i + 1];
-                const uint8_t b = row[i + 2];
-
-                const auto YLinear = static_cast<uint8_t>(0.299 * r + 0.587 * g + 0.114 * b);
-
-                row[i + 0] = YLinear;
-                row[i + 1] = YLinear;
-                row[i + 2] = YLinear;
-            }
+        if (frame.bytesPerPixel() == 0) {
+            logger::error("toGrayScale: unsupported pixel format");
+            return Error{ErrorCode::UnsupportedFormat, "toGrayScale: unsupported pixel format"};
         }
+
+        Backend::active().toGrayScale(frame);
+        return {};
     }
 
-    void Engine::convertRGB24toRGBA32(const engine::Frame &src, engine::Frame &dest) {
+    engine::Expected<void> Engine::convertRGB24toRGBA32(const engine::ConstFrameView src, const engine::FrameView dest) {
         // Safety checks
         if (src.width != dest.width || src.height != dest.height) {
             logger::error("convertRGB24toRGBA32: dimension mismatch between src and dest frame");
-            throw std::runtime_error("convertRGB24toRGBA32: dimension mismatch between src and dest frame");
+            return Error{ErrorCode::InvalidArgument,
+                         "convertRGB24toRGBA32: dimension mismatch between src and dest frame"};
         }
         if (src.pixelFormat != PixelFormat::RGB24) {
             logger::error("convertRGB24toRGBA32: src frame must be in RGB24 format");
-            throw std::runtime_error("convertRGB24toRGBA32: src frame must be in RGB24 format");
+            return Error{ErrorCode::UnsupportedFormat, "convertRGB24toRGBA32: src frame must be in RGB24 format"};
         }
         if (dest.pixelFormat != PixelFormat::RGBA32) {
             logger::error("convertRGB24toRGBA32: dest frame must be in RGBA32 format");
-            throw std::runtime_error("convertRGB24toRGBA32: dest frame must be in RGBA32 format");
+            return Error{ErrorCode::UnsupportedFormat, "convertRGB24toRGBA32: dest frame must be in RGBA32 format"};
         }
 
-        const int width = src.width;
-        const int height = src.height;
+        Backend::active().convert(src, dest);
+        return {};
+    }
+
+    engine::Expected<void> Engine::resize(const engine::ConstFrameView src, const engine::FrameView dest) {
+        if (src.pixelFormat != dest.pixelFormat || src.bytesPerPixel() == 0) {
+            logger::error("resize: src and dest must share a supported pixel format");
+            return Error{ErrorCode::UnsupportedFormat, "resize: src and dest must share a supported pixel format"};
+        }
+        if (src.empty() || dest.empty()) {
+            logger::error("resize: empty src or dest frame");
+            return Error{ErrorCode::InvalidArgument, "resize: empty src or dest frame"};
+        }
 
-        for (int y = 0; y < height; ++y) {
-            // Get pointers to the start of the row
-            const uint8_t *srcRow = src.row(y);
-            uint8_t *destRow = dest.row(y);
+        Backend::active().resize(src, dest);
+        return {};
+    }
 
-            for (int x = 0; x < width; ++x) {
-                // Calculate index for the current pixel
-                // RGB24 stride is 3, RGBA32 stride is 4
-                const int srcIndex = x * src.bytesPerPixel();
-                const int destIndex = x * dest.bytesPerPixel();
+    engine::Expected<void> Engine::blend(const engine::ConstFrameView overlay, const engine::FrameView base,
+                                         const int x, const int y) {
+        if (overlay.pixelFormat != PixelFormat::RGBA32) {
+            logger::error("blend: overlay must be in RGBA32 format");
+            return Error{ErrorCode::UnsupportedFormat, "blend: overlay must be in RGBA32 format"};
+        }
+        if (base.pixelFormat != PixelFormat::RGB24 && base.pixelFormat != PixelFormat::RGBA32) {
+            logger::error("blend: base frame must be in RGB24 or RGBA32 format");
+            return Error{ErrorCode::UnsupportedFormat, "blend: base frame must be in RGB24 or RGBA32 format"};
+        }
 
-                // Copy Colors
-                destRow[destIndex + 0] = srcRow[srcIndex + 0]; // R
-                destRow[destIndex + 1] = srcRow[srcIndex + 1]; // G
-                destRow[destIndex + 2] = srcRow[srcIndex + 2]; // B
+        // Only the part that lands on base is premultiplied, then blended like Compositor overlays
+        const engine::ConstFrameView visible = overlay.sub(-x, -y, base.width, base.height);
+        if (visible.empty()) return {};
 
-                // Add Alpha (255 = Opaque, 0 = Transparent)
-                destRow[destIndex + 3] = 255;
-            }
+        thread_local engine::Frame premultiplied;
+        if (premultiplied.width != visible.width || premultiplied.height != visible.height) {
+            premultiplied = engine::Frame(visible.width, visible.height, PixelFormat::RGBA32);
         }
+        Backend &backend = Backend::active();
+        backend.premultiply(visible, premultiplied);
+        backend.blend(premultiplied, base, x + visible.x - overlay.x, y + visible.y - overlay.y);
+        return {};
     }
 }
@@ -0,0 +1,178 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#include "engine/Filters.h"
+#include "engine/Backend.h"
+#include "backend/cpu/Kernels.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        bool supported(const engine::ConstFrameView &frame, const char *operation) {
+            if (frame.bytesPerPixel() == 0) {
+                logger::error("{}: unsupported pixel format", operation);
+                return false;
+            }
+            return true;
+        }
+    }
+
+    Kernel1D Kernel1D::box(const int radius) {
+        if (radius < 0 || 2 * radius + 1 > cpu::kMaxTaps) {
+            logger::error("Kernel1D::box: radius must be in [0, {}]", cpu::kMaxTaps / 2);
+            throw std::runtime_error("Kernel1D::box: radius out of range");
+        }
+
+        const int taps = 2 * radius + 1;
+        Kernel1D kernel;
+        kernel.weights.assign(taps, static_cast<uint16_t>(256 / taps));
+        kernel.weights[radius] += static_cast<uint16_t>(256 % taps);
+        return kernel;
+    }
+
+    Kernel1D Kernel1D::gaussian(const double sigma) {
+        if (!(sigma > 0)) {
+            logger::error("Kernel1D::gaussian: sigma must be positive");
+            throw std::runtime_error("Kernel1D::gaussian: sigma must be positive");
+        }
+
+        const int radius = std::clamp(static_cast<int>(std::ceil(3.0 * sigma)), 1, cpu::kMaxTaps / 2);
+        std::vector<double> g(2 * radius + 1);
+        for (int i = -radius; i <= radius; i++) {
+            g[i + radius] = std::exp(-(i * i) / (2.0 * sigma * sigma));
+        }
+        const double total = std::accumulate(g.begin(), g.end(), 0.0);
+
+        Kernel1D kernel;
+        kernel.weights.resize(g.size());
+        int sum = 0;
+        for (size_t i = 0; i < g.size(); i++) {
+            kernel.weights[i] = static_cast<uint16_t>(std::lround(256.0 * g[i] / total));
+            sum += kernel.weights[i];
+        }
+        // Rounding error goes to the center tap so the filter keeps brightness exactly
+        kernel.weights[radius] = static_cast<uint16_t>(kernel.weights[radius] + 256 - sum);
+        return kernel;
+    }
+
+    engine::Expected<void> Filters::convolve(const engine::FrameView frame, const Kernel1D &kernel) {
+        if (!supported(frame, "Filters::convolve")) {
+            return Error{ErrorCode::UnsupportedFormat, "Filters::convolve: unsupported pixel format"};
+        }
+        const int taps = static_cast<int>(kernel.weights.size());
+        if (taps % 2 == 0 || taps > cpu::kMaxTaps ||
+            std::accumulate(kernel.weights.begin(), kernel.weights.end(), 0) != 256) {
+            logger::error("Filters::convolve: kernel must have an odd tap count <= {} and sum to 256", cpu::kMaxTaps);
+            return Error{ErrorCode::InvalidArgument, "Filters::convolve: invalid kernel"};
+        }
+        if (taps == 1 || frame.empty()) return {};
+
+        Backend::active().convolve(frame, kernel);
+        return {};
+    }
+
+    engine::Expected<void> Filters::boxBlur(const engine::FrameView frame, const int radius) {
+        if (radius < 0 || 2 * radius + 1 > cpu::kMaxTaps) {
+            logger::error("Filters::boxBlur: radius must be in [0, {}]", cpu::kMaxTaps / 2);
+            return Error{ErrorCode::InvalidArgument, "Filters::boxBlur: radius out of range"};
+        }
+        return convolve(frame, Kernel1D::box(radius));
+    }
+
+    engine::Expected<void> Filters::gaussianBlur(const engine::FrameView frame, const double sigma) {
+        if (!(sigma > 0)) {
+            logger::error("Filters::gaussianBlur: sigma must be positive");
+            return Error{ErrorCode::InvalidArgument, "Filters::gaussianBlur: sigma must be positive"};
+        }
+        return convolve(frame, Kernel1D::gaussian(sigma));
+    }
+
+    engine::Expected<void> Filters::unsharpMask(const engine::FrameView frame, const double sigma,
+                                                const double amount) {
+        if (!supported(frame, "Filters::unsharpMask")) {
+            return Error{ErrorCode::UnsupportedFormat, "Filters::unsharpMask: unsupported pixel format"};
+        }
+        if (amount < 0 || amount > 8) {
+            logger::error("Filters::unsharpMask: amount must be in [0, 8]");
+            return Error{ErrorCode::InvalidArgument, "Filters::unsharpMask: amount must be in [0, 8]"};
+        }
+        if (!(sigma > 0)) {
+            logger::error("Filters::unsharpMask: sigma must be positive");
+            return Error{ErrorCode::InvalidArgument, "Filters::unsharpMask: sigma must be positive"};
+        }
+
+        if (frame.empty()) return {};
+
+        thread_local engine::Frame blurred;
+        if (blurred.width != frame.width || blurred.height != frame.height || blurred.pixelFormat != frame.pixelFormat) {
+            blurred = engine::Frame(frame.width, frame.height, frame.pixelFormat);
+        }
+        const int rowBytes = frame.rowBytes();
+        for (int y = 0; y < frame.height; y++) {
+            std::memcpy(blurred.row(y), frame.row(y), rowBytes);
+        }
+        if (const auto blur = gaussianBlur(blurred, sigma); !blur) {
+            return blur;
+        }
+
+        const int amountQ4 = static_cast<int>(std::lround(amount * 16));
+        const int band = cpu::bandRows(rowBytes);
+        const engine::Frame &source = blurred;
+
+        utils::ThreadPool::shared().parallelFor(frame.height, band, [&](const int y0, const int y1) {
+            for (int y = y0; y < y1; y++) {
+                cpu::unsharp(frame.row(y), source.row(y), amountQ4, frame.row(y), rowBytes);
+            }
+        });
+        return {};
+    }
+
+    engine::Expected<void> Filters::sobel(const engine::ConstFrameView src, engine::Frame &dest) {
+        if (!supported(src, "Filters::sobel")) {
+            return Error{ErrorCode::UnsupportedFormat, "Filters::sobel: unsupported pixel format"};
+        }
+        if (dest.width != src.width || dest.height != src.height || dest.pixelFormat != PixelFormat::GRAY8) {
+            dest = engine::Frame(src.width, src.height, PixelFormat::GRAY8);
+        }
+        dest.pts = src.pts;
+        if (src.empty()) return {};
+
+        const int width = src.width;
+        const int height = src.height;
+        engine::ConstFrameView luma = src;
+        thread_local engine::Frame lumaScratch;
+        if (src.pixelFormat != PixelFormat::GRAY8) {
+            if (lumaScratch.width != width || lumaScratch.height != height) {
+                lumaScratch = engine::Frame(width, height, PixelFormat::GRAY8);
+            }
+            Backend::active().convert(src, lumaScratch);
+            luma = lumaScratch.view();
+        }
+
+        utils::ThreadPool::shared().parallelFor(height, cpu::bandRows(width), [&](const int y0, const int y1) {
+            thread_local std::vector<uint8_t> rows;
+            rows.resize(3 * static_cast<size_t>(width + 2));
+            uint8_t *above = rows.data();
+            uint8_t *row = above + width + 2;
+            uint8_t *below = row + width + 2;
+
+            for (int y = y0; y < y1; y++) {
+                cpu::padRow(luma.row(std::max(y - 1, 0)), width, 1, 1, above);
+                cpu::padRow(luma.row(y), width, 1, 1, row);
+                cpu::padRow(luma.row(std::min(y + 1, height - 1)), width, 1, 1, below);
+                cpu::sobel(above + 1, row + 1, below + 1, dest.row(y), width);
+            }
+        });
+        return {};
+    }
+}
@@ -0,0 +1,221 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <utility>
+
+#include "engine/Fingerprint.h"
+#include "backend/cpu/Kernels.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        constexpr int kBlock = cpu::kDctBlock;
+        constexpr int kTerms = cpu::kDctTerms;
+
+        constexpr char kMagic[4] = {'V', 'P', 'F', 'P'};
+        constexpr uint8_t kVersion = 2; // 2: hashes leave out the DC term
+        constexpr std::size_t kHeaderBytes = 12; // magic, version, 3 reserved, count
+        constexpr std::size_t kEntryBytes = 12; // time in ms, hash
+
+        // Source pixels [begin, end) of output cell i when size pixels map onto kBlock cells.
+        // Never empty, so frames smaller than the block repeat pixels.
+        std::pair<int, int> cellRange(const int i, const int size) {
+            const int begin = i * size / kBlock;
+            return {begin, std::max((i + 1) * size / kBlock, begin + 1)};
+        }
+
+        // Luma area-averaged to kBlock x kBlock, one band of output rows per task
+        void downscale(const engine::ConstFrameView frame, uint8_t *block) {
+            const int bytesPerPixel = frame.bytesPerPixel();
+            const int width = frame.width;
+
+            utils::ThreadPool::shared().parallelFor(kBlock, 4, [&](const int first, const int last) {
+                thread_local std::vector<uint8_t> luma;
+                thread_local std::vector<uint32_t> sums;
+                luma.resize(width);
+                sums.resize(width);
+
+                for (int by = first; by < last; by++) {
+                    const auto [y0, y1] = cellRange(by, frame.height);
+                    std::fill(sums.begin(), sums.end(), 0u);
+                    for (int y = y0; y < y1; y++) {
+                        const uint8_t *row = frame.row(y);
+                        if (bytesPerPixel != 1) {
+                            cpu::lumaFromRGB(row, bytesPerPixel, luma.data(), width);
+                            row = luma.data();
+                        }
+                        for (int x = 0; x < width; x++) {
+                            sums[x] += row[x];
+                        }
+                    }
+
+                    for (int bx = 0; bx < kBlock; bx++) {
+                        const auto [x0, x1] = cellRange(bx, width);
+                        uint64_t total = 0;
+                        for (int x = x0; x < x1; x++) {
+                            total += sums[x];
+                        }
+                        const uint64_t count = static_cast<uint64_t>(x1 - x0) * (y1 - y0);
+                        block[by * kBlock + bx] = static_cast<uint8_t>((total + count / 2) / count);
+                    }
+                }
+            });
+        }
+
+        void put(std::vector<uint8_t> &out, const uint64_t value, const int bytes) {
+            for (int i = 0; i < bytes; i++) {
+                out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        uint64_t get(const uint8_t *in, const int bytes) {
+            uint64_t value = 0;
+            for (int i = 0; i < bytes; i++) {
+                value |= static_cast<uint64_t>(in[i]) << (8 * i);
+            }
+            return value;
+        }
+    }
+
+    engine::Expected<uint64_t> perceptualHash(const engine::ConstFrameView frame) {
+        if (frame.bytesPerPixel() == 0) {
+            logger::error("perceptualHash: unsupported pixel format");
+            return Error{ErrorCode::UnsupportedFormat, "perceptualHash: unsupported pixel format"};
+        }
+        if (frame.empty()) {
+            logger::error("perceptualHash: empty frame");
+            return Error{ErrorCode::InvalidArgument, "perceptualHash: empty frame"};
+        }
+
+        uint8_t block[kBlock * kBlock];
+        downscale(frame, block);
+
+        int32_t coefficients[kTerms * kTerms];
+        cpu::dctLowFrequency(block, kBlock, coefficients);
+
+        // The DC term (index 0) only follows the mean brightness, so it takes no part: the 63 AC terms are
+        // compared with their median, which keeps the hash insensitive to brightness and contrast changes
+        constexpr int kAcTerms = kTerms * kTerms - 1;
+        int32_t sorted[kAcTerms];
+        std::copy(std::begin(coefficients) + 1, std::end(coefficients), sorted);
+        std::nth_element(sorted, sorted + kAcTerms / 2, std::end(sorted));
+        const int32_t median = sorted[kAcTerms / 2];
+
+        uint64_t hash = 0;
+        for (int i = 1; i < kTerms * kTerms; i++) {
+            if (coefficients[i] > median) {
+                hash |= uint64_t{1} << i;
+            }
+        }
+        return hash;
+    }
+
+    int hammingDistance(const uint64_t a, const uint64_t b) {
+        return std::popcount(a ^ b);
+    }
+
+    double Signature::distance(const Signature &other) const {
+        if (hashes.empty() || other.hashes.empty()) return 64;
+
+        double total = 0;
+        for (const FrameHash &a: hashes) {
+            int best = 64;
+            for (const FrameHash &b: other.hashes) {
+                best = std::min(best, hammingDistance(a.hash, b.hash));
+                if (best == 0) break;
+            }
+            total += best;
+        }
+        return total / static_cast<double>(hashes.size());
+    }
+
+    engine::Expected<void> Signature::save(const std::string &path) const {
+        std::vector<uint8_t> bytes;
+        bytes.reserve(kHeaderBytes + hashes.size() * kEntryBytes);
+        bytes.insert(bytes.end(), std::begin(kMagic), std::end(kMagic));
+        put(bytes, kVersion, 4); // version, then 3 reserved bytes
+        put(bytes, hashes.size(), 4);
+        for (const FrameHash &entry: hashes) {
+            put(bytes, static_cast<uint32_t>(std::llround(std::max(entry.time, 0.0) * 1000)), 4);
+            put(bytes, entry.hash, 8);
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        if (!file) {
+            logger::error("Signature::save: could not open file for writing: {}", path);
+            return Error{ErrorCode::IOFailure, "Signature::save: could not open file for writing"};
+        }
+        file.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        if (!file.flush()) {
+            logger::error("Signature::save: write failed: {}", path);
+            return Error{ErrorCode::IOFailure, "Signature::save: write failed"};
+        }
+        return {};
+    }
+
+    engine::Expected<Signature> Signature::load(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            logger::error("Signature::load: could not open file: {}", path);
+            return Error{ErrorCode::IOFailure, "Signature::load: could not open file"};
+        }
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        if (bytes.size() < kHeaderBytes || !std::equal(std::begin(kMagic), std::end(kMagic), bytes.begin())) {
+            logger::error("Signature::load: not a signature file: {}", path);
+            return Error{ErrorCode::UnsupportedFormat, "Signature::load: not a signature file"};
+        }
+        if (bytes[4] != kVersion) {
+            logger::error("Signature::load: unsupported version {} in {}", bytes[4], path);
+            return Error{ErrorCode::UnsupportedFormat, "Signature::load: unsupported version"};
+        }
+        const uint64_t count = get(bytes.data() + 8, 4);
+        if (bytes.size() != kHeaderBytes + count * kEntryBytes) {
+            logger::error("Signature::load: truncated or corrupt file: {}", path);
+            return Error{ErrorCode::CorruptData, "Signature::load: truncated or corrupt file"};
+        }
+
+        Signature signature;
+        signature.hashes.resize(count);
+        const uint8_t *entry = bytes.data() + kHeaderBytes;
+        for (FrameHash &hash: signature.hashes) {
+            hash.time = static_cast<double>(get(entry, 4)) / 1000;
+            hash.hash = get(entry + 4, 8);
+            entry += kEntryBytes;
+        }
+        return signature;
+    }
+
+    FrameHasher::FrameHasher(const double interval, TimeBase toSeconds)
+        : interval(std::max(interval, 0.0)), toSeconds(std::move(toSeconds)) {
+    }
+
+    engine::Expected<bool> FrameHasher::process(const engine::FrameView frame) {
+        const double time = toSeconds ? toSeconds(frame.pts) : static_cast<double>(frame.pts);
+        if (!result.hashes.empty() && time < nextTime) {
+            return true;
+        }
+
+        const engine::Expected<uint64_t> hash = perceptualHash(frame);
+        if (!hash) {
+            return hash.error();
+        }
+        result.hashes.push_back({time, *hash});
+        nextTime = time + interval;
+        return true;
+    }
+
+    void FrameHasher::reset() {
+        result.hashes.clear();
+        nextTime = 0;
+    }
+}
@@ -0,0 +1,83 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "engine/FrameRing.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        constexpr std::size_t kSlotAlignment = 64;
+    }
+
+    FrameRing::FrameRing(const int historyFrames, const int width, const int height, const PixelFormat pixelFormat) {
+        if (const auto configured = configure(historyFrames, width, height, pixelFormat); !configured) {
+            throw std::runtime_error(configured.error().message);
+        }
+    }
+
+    engine::Expected<void> FrameRing::configure(const int historyFrames, const int width, const int height,
+                                                const PixelFormat pixelFormat) {
+        if (historyFrames < 1 || width <= 0 || height <= 0 || pixelFormat == PixelFormat::UNKNOWN) {
+            logger::error("FrameRing::configure: invalid ring geometry");
+            return Error{ErrorCode::InvalidArgument, "FrameRing::configure: invalid ring geometry"};
+        }
+        if (slots == historyFrames + 1 && matches(width, height, pixelFormat)) {
+            return {};
+        }
+
+        this->width = width;
+        this->height = height;
+        this->pixelFormat = pixelFormat;
+        stride = bytesPerPixel(pixelFormat) * width;
+        slots = historyFrames + 1;
+
+        // Slots start on cache-line boundaries so bands of different slots never share a line
+        slotBytes = (static_cast<std::size_t>(stride) * height + kSlotAlignment - 1) / kSlotAlignment * kSlotAlignment;
+        arena.assign(slotBytes * slots, 0);
+        slotPts.assign(slots, 0);
+        clear();
+        return {};
+    }
+
+    void FrameRing::clear() {
+        head = 0;
+        count = 0;
+    }
+
+    int FrameRing::size() const {
+        return std::min(count, slots - 1);
+    }
+
+    const uint8_t *FrameRing::slotData(const int slot) const {
+        return arena.data() + slotBytes * slot;
+    }
+
+    const uint8_t *FrameRing::row(const int age, const int y) const {
+        const int slot = (head - 1 - age + 2 * slots) % slots;
+        return slotData(slot) + static_cast<std::size_t>(y) * stride;
+    }
+
+    int64_t FrameRing::pts(const int age) const {
+        return slotPts[(head - 1 - age + 2 * slots) % slots];
+    }
+
+    uint8_t *FrameRing::writeRow(const int y) {
+        return arena.data() + slotBytes * head + static_cast<std::size_t>(y) * stride;
+    }
+
+    void FrameRing::commit(const int64_t pts) {
+        slotPts[head] = pts;
+        head = (head + 1) % slots;
+        count = std::min(count + 1, slots);
+    }
+
+    bool FrameRing::matches(const int width, const int height, const PixelFormat pixelFormat) const {
+        return this->width == width && this->height == height && this->pixelFormat == pixelFormat;
+    }
+}
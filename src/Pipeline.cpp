@@ -1,3 +1,302 @@
 //
 // Created by HuyN on 25/12/2025.
-//
\ No newline at end of file
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "engine/Pipeline.h"
+#include "utils/Logger.h"
+#include "utils/Timer.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        // Polling interval while a live source has no data yet
+        constexpr std::chrono::milliseconds kRetryDelay{1};
+
+        // Fills frame from source. False at the end of the stream or once stop is set, throws on a failure.
+        // Frames without an arrival time from the source get the current time.
+        bool pull(const Pipeline::Source &source, engine::Frame &frame, const std::atomic<bool> *stop = nullptr) {
+            frame.arrival = 0;
+            while (true) {
+                const engine::Expected<void> read = source(frame);
+                if (read) break;
+                if (read.is(ErrorCode::EndOfStream)) return false;
+                if (stop && stop->load(std::memory_order_relaxed)) return false;
+                if (!read.is(ErrorCode::TryAgain)) {
+                    logger::error("Pipeline::run: source failed: {}", read.error().message);
+                    throw std::runtime_error(std::string("Pipeline::run: source failed: ") + read.error().message);
+                }
+                std::this_thread::sleep_for(kRetryDelay);
+            }
+            if (frame.arrival == 0) {
+                frame.arrival = utils::nowNanos();
+            }
+            return true;
+        }
+    }
+
+    Pipeline::Pipeline() : Pipeline(engine::Config::current()) {
+    }
+
+    Pipeline::Pipeline(const engine::Config &config)
+        : queueDepth(config.queueDepth), lowLatency(config.lowLatency) {
+    }
+
+    Stage &Pipeline::add(std::unique_ptr<Stage> stage) {
+        if (!stage) {
+            logger::error("Pipeline::add: stage is null");
+            throw std::runtime_error("Pipeline::add: stage is null");
+        }
+        stages.push_back(std::move(stage));
+        return *stages.back();
+    }
+
+    engine::Expected<bool> Pipeline::process(engine::Frame &frame) {
+        for (const auto &stage: stages) {
+            const engine::Expected<bool> kept = stage->process(frame);
+            if (!kept || !*kept) {
+                return kept;
+            }
+        }
+        return true;
+    }
+
+    void Pipeline::reset() {
+        for (const auto &stage: stages) {
+            stage->reset();
+        }
+    }
+
+    std::size_t Pipeline::size() const {
+        return stages.size();
+    }
+
+    void Pipeline::setLowLatency(const bool enabled) {
+        lowLatency = enabled;
+    }
+
+    const PipelineStats &Pipeline::stats() const {
+        return statistics;
+    }
+
+    bool Pipeline::runStages(engine::Frame &frame) {
+        const engine::Expected<bool> kept = process(frame);
+        if (!kept) {
+            logger::error("Pipeline::run: stage failed: {}", kept.error().message);
+            throw std::runtime_error(std::string("Pipeline::run: stage failed: ") + kept.error().message);
+        }
+        return *kept;
+    }
+
+    void Pipeline::deliver(engine::Frame &frame, const Sink &sink) {
+        const double latency = utils::millisecondsSince(frame.arrival);
+        statistics.delivered++;
+        statistics.lastLatencyMs = latency;
+        statistics.meanLatencyMs += (latency - statistics.meanLatencyMs) / static_cast<double>(statistics.delivered);
+        statistics.maxLatencyMs = std::max(statistics.maxLatencyMs, latency);
+        sink(frame);
+    }
+
+    std::size_t Pipeline::run(const int width, const int height, const PixelFormat format, const Source &source,
+                              const Sink &sink, const Interrupt &interrupt) {
+        statistics = {};
+        if (lowLatency) {
+            return runLatest(width, height, format, source, sink, interrupt);
+        }
+        if (queueDepth > 0) {
+            return runQueued(width, height, format, source, sink, interrupt);
+        }
+
+        engine::Frame frame(width, height, format);
+        while (pull(source, frame)) {
+            if (runStages(frame)) {
+                deliver(frame, sink);
+            }
+        }
+        return statistics.delivered;
+    }
+
+    std::size_t Pipeline::runQueued(const int width, const int height, const PixelFormat format, const Source &source,
+                                    const Sink &sink, const Interrupt &interrupt) {
+        // Frames cycle free -> source -> ready -> stages and sink -> free. One more frame than the
+        // queue depth, so the source can fill one while the stages work on another.
+        std::vector<engine::Frame> pool(queueDepth + 1, engine::Frame(width, height, format));
+        std::deque<engine::Frame *> free;
+        std::deque<engine::Frame *> ready;
+        for (auto &frame: pool) {
+            free.push_back(&frame);
+        }
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool ended = false; // source finished or failed
+        std::atomic<bool> stopping = false; // the consumer side failed
+        std::exception_ptr error;
+
+        std::thread producer([&] {
+            while (true) {
+                engine::Frame *frame;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return stopping || !free.empty(); });
+                    if (stopping) break;
+                    frame = free.front();
+                    free.pop_front();
+                }
+
+                bool filled = false;
+                try {
+                    filled = pull(source, *frame, &stopping);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!filled) break;
+                ready.push_back(frame);
+                changed.notify_all();
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            ended = true;
+            changed.notify_all();
+        });
+
+        try {
+            while (true) {
+                engine::Frame *frame;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return ended || !ready.empty(); });
+                    if (ready.empty()) break;
+                    frame = ready.front();
+                    ready.pop_front();
+                }
+
+                if (runStages(*frame)) {
+                    deliver(*frame, sink);
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                free.push_back(frame);
+                changed.notify_all();
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+                changed.notify_all();
+            }
+            if (interrupt) interrupt();
+            producer.join();
+            throw;
+        }
+
+        producer.join();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return statistics.delivered;
+    }
+
+    std::size_t Pipeline::runLatest(const int width, const int height, const PixelFormat format, const Source &source,
+                                    const Sink &sink, const Interrupt &interrupt) {
+        // One frame being filled, the newest finished one and one in the stages: the source never waits
+        // for the stages, and a finished frame nobody took yet is recycled when the next one is done
+        std::vector<engine::Frame> pool(3, engine::Frame(width, height, format));
+        std::vector<engine::Frame *> free;
+        for (auto &frame: pool) {
+            free.push_back(&frame);
+        }
+        engine::Frame *latest = nullptr;
+        std::size_t dropped = 0;
+
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool ended = false;
+        std::atomic<bool> stopping = false;
+        std::exception_ptr error;
+
+        std::thread producer([&] {
+            engine::Frame *frame;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                frame = free.back();
+                free.pop_back();
+            }
+
+            while (!stopping.load(std::memory_order_relaxed)) {
+                bool filled = false;
+                try {
+                    filled = pull(source, *frame, &stopping);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    error = std::current_exception();
+                }
+                if (!filled) break;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                if (latest) {
+                    free.push_back(latest);
+                    dropped++;
+                }
+                latest = frame;
+                frame = free.back();
+                free.pop_back();
+                changed.notify_all();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ended = true;
+            changed.notify_all();
+        });
+
+        try {
+            while (true) {
+                engine::Frame *frame;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    changed.wait(lock, [&] { return ended || latest; });
+                    if (!latest) break;
+                    frame = latest;
+                    latest = nullptr;
+                    statistics.dropped = dropped;
+                }
+
+                if (runStages(*frame)) {
+                    deliver(*frame, sink);
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                free.push_back(frame);
+            }
+        } catch (...) {
+            stopping = true;
+            if (interrupt) interrupt();
+            producer.join();
+            throw;
+        }
+
+        producer.join();
+        statistics.dropped = dropped;
+        if (dropped) {
+            logger::warn("Pipeline::run: dropped {} of {} frames to keep up with the input", dropped,
+                         dropped + statistics.delivered);
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return statistics.delivered;
+    }
+}
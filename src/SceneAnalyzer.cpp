@@ -0,0 +1,103 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "engine/SceneAnalyzer.h"
+#include "backend/cpu/Kernels.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    SceneAnalyzer::SceneAnalyzer(SceneAnalyzerOptions options, Callback onEvent)
+        : options(options), onEvent(std::move(onEvent)) {
+        if (this->options.rowStep < 1) {
+            logger::error("SceneAnalyzer: rowStep must be at least 1");
+            throw std::runtime_error("SceneAnalyzer: rowStep must be at least 1");
+        }
+    }
+
+    engine::Expected<bool> SceneAnalyzer::process(const engine::FrameView frame) {
+        const engine::Expected<FrameAnalysis> result = analyze(frame);
+        if (!result) {
+            return result.error();
+        }
+        if ((result->sceneCut || result->duplicate) && onEvent) {
+            onEvent(*result);
+        }
+        return !(result->duplicate && options.dropDuplicates);
+    }
+
+    void SceneAnalyzer::reset() {
+        hasPrevious = false;
+        frameIndex = 0;
+        lastResult = {};
+    }
+
+    engine::Expected<FrameAnalysis> SceneAnalyzer::analyze(const engine::ConstFrameView frame) {
+        if (frame.bytesPerPixel() == 0) {
+            logger::error("SceneAnalyzer::analyze: unsupported pixel format");
+            return Error{ErrorCode::UnsupportedFormat, "SceneAnalyzer::analyze: unsupported pixel format"};
+        }
+
+        const int analyzedRows = (frame.height + options.rowStep - 1) / options.rowStep;
+        if (frame.width != width || analyzedRows != rows) {
+            width = frame.width;
+            rows = analyzedRows;
+            currentLuma.assign(static_cast<size_t>(width) * rows, 0);
+            previousLuma.assign(static_cast<size_t>(width) * rows, 0);
+            hasPrevious = false;
+        }
+
+        currentHistogram.fill(0);
+        uint64_t sad = 0;
+
+        for (int r = 0; r < rows; r++) {
+            const uint8_t *src = frame.row(r * options.rowStep);
+            uint8_t *luma = currentLuma.data() + static_cast<size_t>(r) * width;
+
+            if (frame.pixelFormat == PixelFormat::GRAY8) {
+                std::memcpy(luma, src, width);
+            } else {
+                cpu::lumaFromRGB(src, frame.bytesPerPixel(), luma, width);
+            }
+
+            cpu::histogram(luma, width, currentHistogram.data());
+            if (hasPrevious) {
+                sad += cpu::sad(luma, previousLuma.data() + static_cast<size_t>(r) * width, width);
+            }
+        }
+
+        FrameAnalysis result;
+        result.index = frameIndex++;
+        result.pts = frame.pts;
+
+        const double samples = static_cast<double>(width) * rows;
+        if (!hasPrevious || samples == 0) {
+            result.sceneCut = true;
+        } else {
+            uint64_t distance = 0;
+            for (int v = 0; v < 256; v++) {
+                distance += currentHistogram[v] > previousHistogram[v]
+                                ? currentHistogram[v] - previousHistogram[v]
+                                : previousHistogram[v] - currentHistogram[v];
+            }
+
+            result.meanAbsDiff = static_cast<double>(sad) / samples;
+            result.histogramDistance = static_cast<double>(distance) / (2.0 * samples);
+            result.sceneCut = result.histogramDistance >= options.cutHistogramDistance &&
+                              result.meanAbsDiff >= options.cutMeanAbsDiff;
+            result.duplicate = result.meanAbsDiff <= options.duplicateMeanAbsDiff;
+        }
+
+        std::swap(currentLuma, previousLuma);
+        std::swap(currentHistogram, previousHistogram);
+        hasPrevious = true;
+        lastResult = result;
+        return result;
+    }
+}
@@ -0,0 +1,67 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "engine/TemporalDenoiser.h"
+#include "backend/cpu/Kernels.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    TemporalDenoiser::TemporalDenoiser(const TemporalDenoiseOptions options) : options(options) {
+        if (options.historyFrames < 1 || options.historyFrames > cpu::kMaxHistory) {
+            logger::error("TemporalDenoiser: historyFrames must be in [1, {}]", cpu::kMaxHistory);
+            throw std::runtime_error("TemporalDenoiser: historyFrames out of range");
+        }
+        if (options.threshold < 1 || options.threshold > 255) {
+            logger::error("TemporalDenoiser: threshold must be in [1, 255]");
+            throw std::runtime_error("TemporalDenoiser: threshold out of range");
+        }
+    }
+
+    engine::Expected<bool> TemporalDenoiser::process(const engine::FrameView frame) {
+        if (frame.bytesPerPixel() == 0) {
+            logger::error("TemporalDenoiser::process: unsupported pixel format");
+            return Error{ErrorCode::UnsupportedFormat, "TemporalDenoiser::process: unsupported pixel format"};
+        }
+        if (frame.width == 0 || frame.height == 0) return true;
+
+        // Allocates on the first frame and on geometry changes only
+        if (const auto configured = history.configure(options.historyFrames, frame.width, frame.height,
+                                                      frame.pixelFormat); !configured) {
+            return configured.error();
+        }
+
+        const int rowBytes = frame.width * frame.bytesPerPixel();
+        const int historyCount = history.size();
+        // A band row touches the frame row, the ring's write row and every history row
+        const int band = cpu::bandRows(rowBytes * (historyCount + 2));
+
+        // Each row is copied into the ring's write slot first, then blended from there back into
+        // the frame, so storing the history costs no extra pass over the frame.
+        utils::ThreadPool::shared().parallelFor(frame.height, band, [&](const int y0, const int y1) {
+            const uint8_t *rows[cpu::kMaxHistory];
+            for (int y = y0; y < y1; y++) {
+                uint8_t *current = history.writeRow(y);
+                std::copy_n(frame.row(y), rowBytes, current);
+
+                for (int k = 0; k < historyCount; k++) {
+                    rows[k] = history.row(k, y);
+                }
+                cpu::temporalBlend(current, rows, historyCount, options.threshold, frame.row(y), rowBytes);
+            }
+        });
+
+        history.commit(frame.pts);
+        return true;
+    }
+
+    void TemporalDenoiser::reset() {
+        history.clear();
+    }
+}
@@ -0,0 +1,36 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include "engine/Tiles.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    template<typename T>
+    engine::Expected<void> forEachTile(const BasicFrameView<T> view, const int tileWidth, const int tileHeight,
+                                       const std::type_identity_t<std::function<void(BasicFrameView<T>)> > &fn) {
+        if (tileWidth <= 0 || tileHeight <= 0) {
+            logger::error("forEachTile: tile size must be positive");
+            return Error{ErrorCode::InvalidArgument, "forEachTile: tile size must be positive"};
+        }
+        if (view.empty()) return {};
+
+        const int columns = (view.width + tileWidth - 1) / tileWidth;
+        const int tiles = columns * ((view.height + tileHeight - 1) / tileHeight);
+        utils::ThreadPool::shared().parallelFor(tiles, 1, [&](const int first, const int last) {
+            for (int t = first; t < last; t++) {
+                fn(view.sub((t % columns) * tileWidth, (t / columns) * tileHeight, tileWidth, tileHeight));
+            }
+        });
+        return {};
+    }
+
+    template engine::Expected<void> forEachTile<uint8_t>(
+        engine::FrameView, int, int, const std::type_identity_t<std::function<void(engine::FrameView)> > &);
+
+    template engine::Expected<void> forEachTile<const uint8_t>(
+        engine::ConstFrameView, int, int, const std::type_identity_t<std::function<void(engine::ConstFrameView)> > &);
+}
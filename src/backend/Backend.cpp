@@ -0,0 +1,135 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+
+#include "engine/Backend.h"
+#include "backend/cpu/CpuBackend.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine {
+    namespace {
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::shared_ptr<Backend> > backends;
+            std::atomic<Backend *> active{nullptr};
+        };
+
+        Registry &registry() {
+            // Built-in backends are registered here rather than by static initializers,
+            // which a static library link would drop
+            static Registry *instance = [] {
+                auto *r = new Registry();
+                r->backends.push_back(std::make_shared<cpu::CpuBackend>(cpu::SimdLevel::AVX2));
+                r->backends.push_back(std::make_shared<cpu::CpuBackend>(cpu::SimdLevel::Scalar));
+                return r;
+            }();
+            return *instance;
+        }
+
+        void makeActive(Registry &r, Backend &backend) {
+            backend.activate();
+            r.active.store(&backend, std::memory_order_release);
+            logger::info("Backend: using {}", backend.name());
+        }
+
+        // r.mutex held
+        Backend &named(Registry &r, const std::string &name) {
+            for (const auto &backend: r.backends) {
+                if (name == backend->name()) {
+                    if (!backend->isAvailable()) {
+                        logger::error("Backend::select: backend {} is not available on this machine", name);
+                        throw std::runtime_error("Backend::select: backend not available: " + name);
+                    }
+                    return *backend;
+                }
+            }
+            logger::error("Backend::select: unknown backend {}", name);
+            throw std::runtime_error("Backend::select: unknown backend: " + name);
+        }
+
+        // Whether a should be picked over b: higher priority, then more capabilities
+        bool preferred(const Backend &a, const Backend &b) {
+            if (a.priority() != b.priority()) return a.priority() > b.priority();
+            return std::popcount(a.capabilities()) > std::popcount(b.capabilities());
+        }
+
+        // ENGINE_BACKEND if set, otherwise the preferred available backend; r.mutex held
+        Backend &automatic(Registry &r) {
+            if (const char *forced = std::getenv("ENGINE_BACKEND"); forced && *forced) {
+                return named(r, forced);
+            }
+
+            Backend *best = nullptr;
+            for (const auto &backend: r.backends) {
+                if (backend->isAvailable() && (!best || preferred(*backend, *best))) {
+                    best = backend.get();
+                }
+            }
+            if (!best) {
+                logger::error("Backend::active: no backend available");
+                throw std::runtime_error("Backend::active: no backend available");
+            }
+            return *best;
+        }
+    }
+
+    void Backend::registerBackend(std::shared_ptr<Backend> backend) {
+        if (!backend) {
+            logger::error("Backend::registerBackend: backend is null");
+            throw std::runtime_error("Backend::registerBackend: backend is null");
+        }
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.backends.push_back(std::move(backend));
+    }
+
+    std::vector<std::shared_ptr<Backend> > Backend::registered() {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return r.backends;
+    }
+
+    Backend &Backend::active() {
+        Registry &r = registry();
+        if (Backend *backend = r.active.load(std::memory_order_acquire)) {
+            return *backend;
+        }
+
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (Backend *backend = r.active.load(std::memory_order_acquire)) {
+            return *backend;
+        }
+        Backend &backend = automatic(r);
+        makeActive(r, backend);
+        return backend;
+    }
+
+    void Backend::select(const std::string &name) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        makeActive(r, named(r, name));
+    }
+
+    void Backend::selectDefault() {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        makeActive(r, automatic(r));
+    }
+
+    std::shared_ptr<Backend> Backend::find(const std::string &name) {
+        Registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto &backend: r.backends) {
+            if (name == backend->name()) return backend;
+        }
+        return nullptr;
+    }
+}
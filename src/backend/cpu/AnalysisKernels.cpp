@@ -0,0 +1,127 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <cstdlib>
+
+#include "backend/cpu/Kernels.h"
+
+namespace engine::cpu {
+    namespace scalar {
+        uint64_t sad(const uint8_t *a, const uint8_t *b, const int count) {
+            uint64_t sum = 0;
+            for (int i = 0; i < count; i++) {
+                sum += static_cast<uint64_t>(std::abs(a[i] - b[i]));
+            }
+            return sum;
+        }
+
+        void histogram(const uint8_t *src, const int count, uint32_t *bins) {
+            // Four banks so consecutive equal pixels don't serialize on the same counter
+            uint32_t banks[4][256] = {};
+            int i = 0;
+            for (; i + 4 <= count; i += 4) {
+                banks[0][src[i + 0]]++;
+                banks[1][src[i + 1]]++;
+                banks[2][src[i + 2]]++;
+                banks[3][src[i + 3]]++;
+            }
+            for (; i < count; i++) {
+                banks[0][src[i]]++;
+            }
+            for (int v = 0; v < 256; v++) {
+                bins[v] += banks[0][v] + banks[1][v] + banks[2][v] + banks[3][v];
+            }
+        }
+
+        void lumaFromRGB(const uint8_t *src, const int bytesPerPixel, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                const uint8_t *p = src + x * bytesPerPixel;
+                dest[x] = static_cast<uint8_t>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+            }
+        }
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        namespace {
+            // Luma of 8 pixels with R, G and B in the low three bytes of each 32-bit lane, one per lane
+            ENGINE_TARGET_AVX2 inline __m256i luma8(const __m256i pixels) {
+                const __m256i rb = _mm256_and_si256(pixels, _mm256_set1_epi32(0x00FF00FF));
+                const __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), _mm256_set1_epi32(0xFF));
+                const __m256i sum = _mm256_add_epi32(_mm256_madd_epi16(rb, _mm256_set1_epi32(29 << 16 | 77)),
+                                                     _mm256_madd_epi16(g, _mm256_set1_epi32(150)));
+                return _mm256_srli_epi32(_mm256_add_epi32(sum, _mm256_set1_epi32(128)), 8);
+            }
+
+            // 8 RGB24 pixels spread to one per 32-bit lane; reads 28 bytes
+            ENGINE_TARGET_AVX2 inline __m256i loadRgb8(const uint8_t *src) {
+                const __m256i spread = _mm256_setr_epi8(
+                    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                    0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 12));
+                return _mm256_shuffle_epi8(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), spread);
+            }
+
+            // Two vectors of 8 values below 256 in 32-bit lanes as 16 bytes, in order
+            ENGINE_TARGET_AVX2 inline __m128i packBytes(const __m256i a, const __m256i b) {
+                const __m256i words = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+                return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+            }
+        }
+
+        ENGINE_TARGET_AVX2 void lumaFromRGB(const uint8_t *src, const int bytesPerPixel, uint8_t *dest,
+                                            const int count) {
+            int x = 0;
+            if (bytesPerPixel == 4) {
+                for (; x + 16 <= count; x += 16) {
+                    const auto *p = reinterpret_cast<const __m256i *>(src + x * 4);
+                    const __m128i luma = packBytes(luma8(_mm256_loadu_si256(p)), luma8(_mm256_loadu_si256(p + 1)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), luma);
+                }
+            } else if (bytesPerPixel == 3) {
+                // The second half loads up to byte 3 * x + 52
+                for (; x + 18 <= count; x += 16) {
+                    const uint8_t *p = src + x * 3;
+                    const __m128i luma = packBytes(luma8(loadRgb8(p)), luma8(loadRgb8(p + 24)));
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + x), luma);
+                }
+            }
+            scalar::lumaFromRGB(src + x * bytesPerPixel, bytesPerPixel, dest + x, count - x);
+        }
+
+        ENGINE_TARGET_AVX2 uint64_t sad(const uint8_t *a, const uint8_t *b, const int count) {
+            __m256i acc = _mm256_setzero_si256();
+            int i = 0;
+            for (; i + 32 <= count; i += 32) {
+                const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                acc = _mm256_add_epi64(acc, _mm256_sad_epu8(va, vb));
+            }
+
+            alignas(32) uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar::sad(a + i, b + i, count - i);
+        }
+    }
+#endif
+
+    uint64_t sad(const uint8_t *a, const uint8_t *b, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::sad(a, b, count);
+#endif
+        return scalar::sad(a, b, count);
+    }
+
+    void histogram(const uint8_t *src, const int count, uint32_t *bins) {
+        scalar::histogram(src, count, bins);
+    }
+
+    void lumaFromRGB(const uint8_t *src, const int bytesPerPixel, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::lumaFromRGB(src, bytesPerPixel, dest, count);
+#endif
+        scalar::lumaFromRGB(src, bytesPerPixel, dest, count);
+    }
+}
@@ -0,0 +1,136 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "backend/cpu/Kernels.h"
+
+namespace engine::cpu {
+    namespace {
+        // x / 255 rounded, exact for x in [0, 255 * 255]
+        inline uint32_t div255(const uint32_t x) {
+            const uint32_t t = x + 128;
+            return (t + (t >> 8)) >> 8;
+        }
+    }
+
+    namespace scalar {
+        void premultiply(const uint8_t *src, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                const uint32_t a = src[x * 4 + 3];
+                for (int c = 0; c < 3; c++) {
+                    dest[x * 4 + c] = static_cast<uint8_t>(div255(src[x * 4 + c] * a));
+                }
+                dest[x * 4 + 3] = static_cast<uint8_t>(a);
+            }
+        }
+
+        void blendPremultiplied(const uint8_t *overlay, uint8_t *base, const int baseBytesPerPixel, const int count) {
+            for (int x = 0; x < count; x++) {
+                const uint8_t *o = overlay + x * 4;
+                uint8_t *b = base + x * baseBytesPerPixel;
+                const uint32_t inverse = 255 - o[3];
+                for (int c = 0; c < 3; c++) {
+                    b[c] = static_cast<uint8_t>(std::min<uint32_t>(255, o[c] + div255(b[c] * inverse)));
+                }
+            }
+        }
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        namespace {
+            // div255 on 16-bit lanes (inputs up to 255 * 255)
+            ENGINE_TARGET_AVX2 inline __m256i div255(const __m256i x) {
+                const __m256i t = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+                return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8);
+            }
+
+            // div255(pixels * factors) per byte, 8 pixels
+            ENGINE_TARGET_AVX2 inline __m256i scale(const __m256i pixels, const __m256i factors) {
+                const __m256i zero = _mm256_setzero_si256();
+                const __m256i lo = div255(_mm256_mullo_epi16(_mm256_unpacklo_epi8(pixels, zero),
+                                                             _mm256_unpacklo_epi8(factors, zero)));
+                const __m256i hi = div255(_mm256_mullo_epi16(_mm256_unpackhi_epi8(pixels, zero),
+                                                             _mm256_unpackhi_epi8(factors, zero)));
+                return _mm256_packus_epi16(lo, hi);
+            }
+
+            ENGINE_TARGET_AVX2 inline __m256i broadcastAlpha(const __m256i rgba) {
+                const __m256i spread = _mm256_setr_epi8(3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15,
+                                                        3, 3, 3, 3, 7, 7, 7, 7, 11, 11, 11, 11, 15, 15, 15, 15);
+                return _mm256_shuffle_epi8(rgba, spread);
+            }
+        }
+
+        ENGINE_TARGET_AVX2 void premultiply(const uint8_t *src, uint8_t *dest, const int count) {
+            const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+            int x = 0;
+            for (; x + 8 <= count; x += 8) {
+                const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x * 4));
+                const __m256i out = _mm256_blendv_epi8(scale(v, broadcastAlpha(v)), v, alphaMask);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x * 4), out);
+            }
+            scalar::premultiply(src + x * 4, dest + x * 4, count - x);
+        }
+
+        ENGINE_TARGET_AVX2 void blendPremultiplied(const uint8_t *overlay, uint8_t *base, const int baseBytesPerPixel,
+                                                   const int count) {
+            const __m256i ones = _mm256_set1_epi8(static_cast<char>(0xFF));
+            int x = 0;
+            if (baseBytesPerPixel == 4) {
+                const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+                for (; x + 8 <= count; x += 8) {
+                    const __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(overlay + x * 4));
+                    auto *p = reinterpret_cast<__m256i *>(base + x * 4);
+                    const __m256i b = _mm256_loadu_si256(p);
+                    const __m256i inverse = _mm256_xor_si256(broadcastAlpha(o), ones); // 255 - a
+                    const __m256i out = _mm256_adds_epu8(o, scale(b, inverse));
+                    _mm256_storeu_si256(p, _mm256_blendv_epi8(out, b, alphaMask)); // base alpha kept
+                }
+            } else if (baseBytesPerPixel == 3) {
+                // 4 RGB24 pixels per 128-bit lane, widened to RGBX and packed back after blending
+                const __m256i widen = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                                                       0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+                const __m256i narrow = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                                                        0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+                // The upper lane loads 16 bytes from pixel 4, i.e. 4 bytes past the 8 pixels
+                for (; x + 10 <= count; x += 8) {
+                    const __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(overlay + x * 4));
+                    uint8_t *p = base + x * 3;
+                    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 12));
+                    const __m256i b = _mm256_shuffle_epi8(
+                        _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1), widen);
+                    const __m256i inverse = _mm256_xor_si256(broadcastAlpha(o), ones);
+                    const __m256i out = _mm256_shuffle_epi8(_mm256_adds_epu8(o, scale(b, inverse)), narrow);
+
+                    // Lower lane's 4 spare bytes are overwritten by the upper lane right after
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(p), _mm256_castsi256_si128(out));
+                    const __m128i upper = _mm256_extracti128_si256(out, 1);
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(p + 12), upper);
+                    const int last = _mm_extract_epi32(upper, 2);
+                    std::memcpy(p + 20, &last, 4);
+                }
+            }
+            scalar::blendPremultiplied(overlay + x * 4, base + x * baseBytesPerPixel, baseBytesPerPixel, count - x);
+        }
+    }
+#endif
+
+    void premultiply(const uint8_t *src, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::premultiply(src, dest, count);
+#endif
+        scalar::premultiply(src, dest, count);
+    }
+
+    void blendPremultiplied(const uint8_t *overlay, uint8_t *base, const int baseBytesPerPixel, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::blendPremultiplied(overlay, base, baseBytesPerPixel, count);
+#endif
+        scalar::blendPremultiplied(overlay, base, baseBytesPerPixel, count);
+    }
+}
@@ -0,0 +1,137 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "backend/cpu/Kernels.h"
+
+namespace engine::cpu {
+    namespace scalar {
+        void weightedSum(const uint8_t *const *sources, const uint16_t *weights, const int taps, uint8_t *dest,
+                         const int count) {
+            for (int i = 0; i < count; i++) {
+                uint32_t sum = 128;
+                for (int k = 0; k < taps; k++) {
+                    sum += static_cast<uint32_t>(weights[k]) * sources[k][i];
+                }
+                dest[i] = static_cast<uint8_t>(sum >> 8);
+            }
+        }
+
+        void unsharp(const uint8_t *src, const uint8_t *blurred, const int amountQ4, uint8_t *dest, const int count) {
+            for (int i = 0; i < count; i++) {
+                const int detail = src[i] - blurred[i];
+                const int value = src[i] + ((detail * amountQ4 + 8) >> 4);
+                dest[i] = static_cast<uint8_t>(std::clamp(value, 0, 255));
+            }
+        }
+
+        void sobel(const uint8_t *above, const uint8_t *row, const uint8_t *below, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                const int gx = (above[x + 1] - above[x - 1]) + 2 * (row[x + 1] - row[x - 1]) + (below[x + 1] - below[x - 1]);
+                const int gy = (below[x - 1] - above[x - 1]) + 2 * (below[x] - above[x]) + (below[x + 1] - above[x + 1]);
+                dest[x] = static_cast<uint8_t>(std::min(255, std::abs(gx) + std::abs(gy)));
+            }
+        }
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        namespace {
+            ENGINE_TARGET_AVX2 inline __m256i load16(const uint8_t *p) {
+                return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+            }
+
+            // Saturating pack of 16 int16 lanes into 16 bytes
+            ENGINE_TARGET_AVX2 inline void store16(uint8_t *p, const __m256i v) {
+                const __m128i packed = _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(p), packed);
+            }
+        }
+
+        ENGINE_TARGET_AVX2 void weightedSum(const uint8_t *const *sources, const uint16_t *weights, const int taps,
+                                            uint8_t *dest, const int count) {
+            const __m256i bias = _mm256_set1_epi16(128);
+            int i = 0;
+            for (; i + 16 <= count; i += 16) {
+                // Unsigned 16-bit lanes: the sum is at most 255 * 256 + 128
+                __m256i sum = bias;
+                for (int k = 0; k < taps; k++) {
+                    const __m256i weight = _mm256_set1_epi16(static_cast<short>(weights[k]));
+                    sum = _mm256_add_epi16(sum, _mm256_mullo_epi16(load16(sources[k] + i), weight));
+                }
+                store16(dest + i, _mm256_srli_epi16(sum, 8));
+            }
+
+            if (i < count) {
+                const uint8_t *tail[kMaxTaps];
+                for (int k = 0; k < taps; k++) {
+                    tail[k] = sources[k] + i;
+                }
+                scalar::weightedSum(tail, weights, taps, dest + i, count - i);
+            }
+        }
+
+        ENGINE_TARGET_AVX2 void unsharp(const uint8_t *src, const uint8_t *blurred, const int amountQ4, uint8_t *dest,
+                                        const int count) {
+            const __m256i amount = _mm256_set1_epi16(static_cast<short>(amountQ4));
+            const __m256i round = _mm256_set1_epi16(8);
+            int i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m256i s = load16(src + i);
+                const __m256i detail = _mm256_sub_epi16(s, load16(blurred + i));
+                const __m256i boost = _mm256_srai_epi16(_mm256_add_epi16(_mm256_mullo_epi16(detail, amount), round), 4);
+                store16(dest + i, _mm256_add_epi16(s, boost));
+            }
+            scalar::unsharp(src + i, blurred + i, amountQ4, dest + i, count - i);
+        }
+
+        ENGINE_TARGET_AVX2 void sobel(const uint8_t *above, const uint8_t *row, const uint8_t *below, uint8_t *dest,
+                                      const int count) {
+            int x = 0;
+            for (; x + 16 <= count; x += 16) {
+                const __m256i aL = load16(above + x - 1), a = load16(above + x), aR = load16(above + x + 1);
+                const __m256i rL = load16(row + x - 1), rR = load16(row + x + 1);
+                const __m256i bL = load16(below + x - 1), b = load16(below + x), bR = load16(below + x + 1);
+
+                const __m256i dA = _mm256_sub_epi16(aR, aL);
+                const __m256i dR = _mm256_sub_epi16(rR, rL);
+                const __m256i dB = _mm256_sub_epi16(bR, bL);
+                const __m256i gx = _mm256_add_epi16(_mm256_add_epi16(dA, dB), _mm256_add_epi16(dR, dR));
+
+                const __m256i dL = _mm256_sub_epi16(bL, aL);
+                const __m256i dC = _mm256_sub_epi16(b, a);
+                const __m256i dRt = _mm256_sub_epi16(bR, aR);
+                const __m256i gy = _mm256_add_epi16(_mm256_add_epi16(dL, dRt), _mm256_add_epi16(dC, dC));
+
+                store16(dest + x, _mm256_add_epi16(_mm256_abs_epi16(gx), _mm256_abs_epi16(gy)));
+            }
+            scalar::sobel(above + x, row + x, below + x, dest + x, count - x);
+        }
+    }
+#endif
+
+    void weightedSum(const uint8_t *const *sources, const uint16_t *weights, const int taps, uint8_t *dest,
+                     const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::weightedSum(sources, weights, taps, dest, count);
+#endif
+        scalar::weightedSum(sources, weights, taps, dest, count);
+    }
+
+    void unsharp(const uint8_t *src, const uint8_t *blurred, const int amountQ4, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::unsharp(src, blurred, amountQ4, dest, count);
+#endif
+        scalar::unsharp(src, blurred, amountQ4, dest, count);
+    }
+
+    void sobel(const uint8_t *above, const uint8_t *row, const uint8_t *below, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::sobel(above, row, below, dest, count);
+#endif
+        scalar::sobel(above, row, below, dest, count);
+    }
+}
@@ -1,3 +1,274 @@
 //
 // Created by HuyN on 25/12/2025.
-//
\ No newline at end of file
+//
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "backend/cpu/CpuBackend.h"
+#include "backend/cpu/Kernels.h"
+#include "engine/Tiles.h"
+#include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine::cpu {
+    namespace {
+        int bandHeight(const int rowBytes, const int radius = 0) {
+            return std::max(4 * radius, bandRows(rowBytes));
+        }
+
+        // Bilinear source coordinate of every destination pixel (pixel centers aligned):
+        // index of the left/top sample and the Q8 weight of the right/bottom one
+        void bilinearTable(const int srcSize, const int destSize, std::vector<int32_t> &index,
+                           std::vector<uint16_t> &weight) {
+            index.resize(destSize);
+            weight.resize(destSize);
+            const double scale = static_cast<double>(srcSize) / destSize;
+            for (int i = 0; i < destSize; i++) {
+                const double s = std::clamp((i + 0.5) * scale - 0.5, 0.0, static_cast<double>(srcSize - 1));
+                int left = static_cast<int>(s);
+                int w = static_cast<int>(std::lround((s - left) * 256));
+                // Keep left + 1 inside the source; the last sample is reached with full weight
+                if (left >= srcSize - 1) {
+                    left = std::max(srcSize - 2, 0);
+                    w = srcSize > 1 ? 256 : 0;
+                }
+                index[i] = left;
+                weight[i] = static_cast<uint16_t>(w);
+            }
+        }
+    }
+
+    CpuBackend::CpuBackend(const SimdLevel level) : level(level) {
+    }
+
+    const char *CpuBackend::name() const {
+        return level == SimdLevel::AVX2 ? "cpu-avx2" : "cpu-scalar";
+    }
+
+    uint32_t CpuBackend::capabilities() const {
+        return BackendCapability::MultiThreaded | (level == SimdLevel::AVX2 ? BackendCapability::SIMD : 0u);
+    }
+
+    int CpuBackend::priority() const {
+        return level == SimdLevel::AVX2 ? 20 : 10;
+    }
+
+    bool CpuBackend::isAvailable() const {
+        return level <= detectSimdLevel();
+    }
+
+    void CpuBackend::activate() {
+        setSimdLevel(level);
+    }
+
+    void CpuBackend::convert(const engine::ConstFrameView src, const engine::FrameView dest) {
+        const PixelFormat from = src.pixelFormat;
+        const PixelFormat to = dest.pixelFormat;
+        const int width = src.width;
+
+        utils::ThreadPool::shared().parallelFor(src.height, bandHeight(src.rowBytes()), [&](const int y0, const int y1) {
+            for (int y = y0; y < y1; y++) {
+                const uint8_t *s = src.row(y);
+                uint8_t *d = dest.row(y);
+                if (from == to) {
+                    std::memcpy(d, s, static_cast<size_t>(width) * src.bytesPerPixel());
+                } else if (from == PixelFormat::RGB24 && to == PixelFormat::RGBA32) {
+                    rgbToRgba(s, d, width);
+                } else if (from == PixelFormat::RGBA32 && to == PixelFormat::RGB24) {
+                    rgbaToRgb(s, d, width);
+                } else if (to == PixelFormat::GRAY8) {
+                    lumaFromRGB(s, src.bytesPerPixel(), d, width);
+                } else {
+                    grayToRgb(s, dest.bytesPerPixel(), d, width);
+                }
+            }
+        });
+    }
+
+    void CpuBackend::toGrayScale(const engine::FrameView frame) {
+        const int bytesPerPixel = frame.bytesPerPixel();
+        utils::ThreadPool::shared().parallelFor(frame.height, bandHeight(frame.rowBytes()), [&](const int y0, const int y1) {
+            for (int y = y0; y < y1; y++) {
+                grayInPlace(frame.row(y), bytesPerPixel, frame.width);
+            }
+        });
+    }
+
+    void CpuBackend::resize(const engine::ConstFrameView src, const engine::FrameView dest) {
+        const int bytesPerPixel = src.bytesPerPixel();
+
+        std::vector<int32_t> columns, rows;
+        std::vector<uint16_t> columnWeights, rowWeights;
+        bilinearTable(src.width, dest.width, columns, columnWeights);
+        bilinearTable(src.height, dest.height, rows, rowWeights);
+        for (int32_t &column: columns) {
+            column *= bytesPerPixel;
+        }
+
+        const int destRowBytes = dest.width * bytesPerPixel;
+        utils::ThreadPool::shared().parallelFor(dest.height, bandHeight(destRowBytes), [&](const int y0, const int y1) {
+            thread_local std::vector<uint8_t> padded, top, bottom;
+            padded.resize(static_cast<size_t>(src.width + 1) * bytesPerPixel);
+            top.resize(destRowBytes);
+            bottom.resize(destRowBytes);
+            int topRow = -1, bottomRow = -1;
+
+            // Horizontal pass on a copy with one extra edge pixel, so `left + 1` is always readable
+            auto horizontal = [&](const int sy, std::vector<uint8_t> &out) {
+                const uint8_t *row = src.row(sy);
+                if (src.width == 1) {
+                    padRow(row, 1, bytesPerPixel, 1, padded.data());
+                    row = padded.data() + bytesPerPixel;
+                }
+                resizeRow(row, bytesPerPixel, columns.data(), columnWeights.data(), out.data(), dest.width);
+            };
+
+            for (int y = y0; y < y1; y++) {
+                const int sy = rows[y];
+                const int sy1 = std::min(sy + 1, src.height - 1);
+                // Upscaling reuses the two horizontally resampled rows across several output rows
+                if (topRow != sy) {
+                    if (bottomRow == sy) {
+                        std::swap(top, bottom);
+                        bottomRow = -1;
+                    } else {
+                        horizontal(sy, top);
+                    }
+                    topRow = sy;
+                }
+                if (bottomRow != sy1) {
+                    horizontal(sy1, bottom);
+                    bottomRow = sy1;
+                }
+
+                const uint8_t *sources[2] = {top.data(), bottom.data()};
+                const uint16_t weights[2] = {static_cast<uint16_t>(256 - rowWeights[y]), rowWeights[y]};
+                weightedSum(sources, weights, 2, dest.row(y), destRowBytes);
+            }
+        });
+    }
+
+    void CpuBackend::convolve(const engine::FrameView frame, const Kernel1D &kernel) {
+        const int taps = static_cast<int>(kernel.weights.size());
+        const int radius = kernel.radius();
+        const int bytesPerPixel = frame.bytesPerPixel();
+        const int width = frame.width;
+        const int height = frame.height;
+        const int rowBytes = frame.rowBytes();
+        const uint16_t *weights = kernel.weights.data();
+
+        // Horizontal pass of source row y into dest
+        auto horizontal = [&](const int y, uint8_t *dest) {
+            thread_local std::vector<uint8_t> padded;
+            padded.resize(static_cast<size_t>(width + 2 * radius) * bytesPerPixel);
+            padRow(frame.row(y), width, bytesPerPixel, radius, padded.data());
+
+            const uint8_t *sources[kMaxTaps];
+            for (int k = 0; k < taps; k++) {
+                sources[k] = padded.data() + k * bytesPerPixel;
+            }
+            weightedSum(sources, weights, taps, dest, rowBytes);
+        };
+
+        // Bands are filtered in place, top to bottom, through a ring of the last `taps` horizontally
+        // filtered rows. Only the radius rows on either side of a band boundary are read by two bands,
+        // and the band that owns them may overwrite them first, so they are filtered up front.
+        const int band = bandHeight(rowBytes, radius);
+        const int boundaries = (height - 1) / band;
+        std::vector<uint8_t> halo(static_cast<size_t>(boundaries) * 2 * radius * rowBytes);
+        auto haloRow = [&](const int boundary, const int r) {
+            return halo.data() + (static_cast<size_t>(boundary) * 2 * radius + r) * rowBytes;
+        };
+
+        auto &pool = utils::ThreadPool::shared();
+        pool.parallelFor(boundaries, 1, [&](const int first, const int last) {
+            for (int b = first; b < last; b++) {
+                const int y = (b + 1) * band;
+                for (int r = 0; r < 2 * radius; r++) {
+                    horizontal(std::min(y - radius + r, height - 1), haloRow(b, r));
+                }
+            }
+        });
+
+        (void) forEachTile(frame, width, band, [&](const engine::FrameView area) {
+            thread_local std::vector<uint8_t> ring;
+            ring.resize(static_cast<size_t>(taps) * rowBytes);
+
+            const int y0 = area.y - frame.y;
+            const int y1 = y0 + area.height;
+            const int b = y0 / band;
+            auto filtered = [&](int y) -> const uint8_t * {
+                y = std::clamp(y, 0, height - 1);
+                if (y < y0) return haloRow(b - 1, y - (y0 - radius));
+                if (y >= y1) return haloRow(b, radius + y - y1);
+                return ring.data() + static_cast<size_t>((y - y0) % taps) * rowBytes;
+            };
+
+            // A source row enters the ring before the output row that overwrites it is written
+            for (int y = y0; y < std::min(y0 + radius, y1); y++) {
+                horizontal(y, ring.data() + static_cast<size_t>((y - y0) % taps) * rowBytes);
+            }
+            const uint8_t *sources[kMaxTaps];
+            for (int y = y0; y < y1; y++) {
+                if (y + radius < y1) {
+                    horizontal(y + radius, ring.data() + static_cast<size_t>((y + radius - y0) % taps) * rowBytes);
+                }
+                for (int k = 0; k < taps; k++) {
+                    sources[k] = filtered(y - radius + k);
+                }
+                weightedSum(sources, weights, taps, frame.row(y), rowBytes);
+            }
+        });
+    }
+
+    void CpuBackend::premultiply(const engine::ConstFrameView src, const engine::FrameView dest) {
+        utils::ThreadPool::shared().parallelFor(src.height, bandHeight(2 * src.rowBytes()), [&](const int y0, const int y1) {
+            for (int y = y0; y < y1; y++) {
+                cpu::premultiply(src.row(y), dest.row(y), src.width);
+            }
+        });
+    }
+
+    void CpuBackend::blend(const engine::ConstFrameView overlay, const engine::FrameView base, const int x, const int y,
+                           const OverlaySpans *spans) {
+        // Clip the overlay rectangle to the base frame
+        const int left = std::max(x, 0);
+        const int top = std::max(y, 0);
+        const int right = std::min(x + overlay.width, base.width);
+        const int bottom = std::min(y + overlay.height, base.height);
+        if (left >= right || top >= bottom) return;
+
+        // Overlay columns that land inside the frame
+        const int clipBegin = left - x;
+        const int clipEnd = right - x;
+        const int bytesPerPixel = base.bytesPerPixel();
+        const int band = bandHeight(2 * (right - left) * 4); // overlay row in, base row read and written
+
+        utils::ThreadPool::shared().parallelFor(bottom - top, band, [&](const int r0, const int r1) {
+            for (int r = r0; r < r1; r++) {
+                const int row = top - y + r;
+                const uint8_t *source = overlay.row(row);
+                uint8_t *dest = base.row(top + r);
+                if (!spans) {
+                    blendPremultiplied(source + clipBegin * 4, dest + left * bytesPerPixel, bytesPerPixel,
+                                       clipEnd - clipBegin);
+                    continue;
+                }
+
+                for (int s = spans->rowSpans[row]; s < spans->rowSpans[row + 1]; s++) {
+                    const int begin = std::max(spans->spans[s].begin, clipBegin);
+                    const int end = std::min(spans->spans[s].end, clipEnd);
+                    if (begin >= end) continue;
+                    blendPremultiplied(source + begin * 4, dest + (x + begin) * bytesPerPixel, bytesPerPixel,
+                                       end - begin);
+                }
+            }
+        });
+    }
+}
@@ -5,4 +5,45 @@
 #ifndef ENGINE_CPUBACKEND_H
 #define ENGINE_CPUBACKEND_H
 
-#endif //ENGINE_CPUBACKEND_H
\ No newline at end of file
+#pragma once
+
+#include "engine/Backend.h"
+#include "backend/cpu/Simd.h"
+
+namespace engine::cpu {
+    // Row kernels from Kernels.h run over parallel row bands on the shared ThreadPool. Convolutions
+    // filter each band in place through a ring of kernel-height rows, so no frame-sized scratch is kept.
+    // One instance per SIMD level is registered ("cpu-avx2", "cpu-scalar").
+    class CpuBackend final : public Backend {
+    public:
+        explicit CpuBackend(SimdLevel level);
+
+        [[nodiscard]] const char *name() const override;
+
+        [[nodiscard]] uint32_t capabilities() const override;
+
+        [[nodiscard]] int priority() const override;
+
+        [[nodiscard]] bool isAvailable() const override;
+
+        void activate() override;
+
+        void convert(engine::ConstFrameView src, engine::FrameView dest) override;
+
+        void toGrayScale(engine::FrameView frame) override;
+
+        void resize(engine::ConstFrameView src, engine::FrameView dest) override;
+
+        void convolve(engine::FrameView frame, const Kernel1D &kernel) override;
+
+        void premultiply(engine::ConstFrameView src, engine::FrameView dest) override;
+
+        void blend(engine::ConstFrameView overlay, engine::FrameView base, int x, int y,
+                   const OverlaySpans *spans) override;
+
+    private:
+        SimdLevel level;
+    };
+}
+
+#endif //ENGINE_CPUBACKEND_H
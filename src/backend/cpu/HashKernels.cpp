@@ -0,0 +1,107 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <cmath>
+#include <numbers>
+
+#include "backend/cpu/Kernels.h"
+
+namespace engine::cpu {
+    namespace {
+        // Basis functions in Q11, scaled like the orthonormal DCT-II (the DC row by 1/sqrt(2)).
+        // Every value fits in 16 bits; products and sums stay exact in 32-bit integers, so the scalar
+        // and AVX2 versions agree bit for bit.
+        constexpr int kBasisShift = 11;
+        constexpr int kRound = 1 << (kBasisShift - 1);
+
+        struct DctTable {
+            int32_t rows[kDctTerms][kDctBlock]; // rows[u][x]
+            // pairs[p][u] = {rows[u][2p], rows[u][2p + 1]}, the layout _mm256_madd_epi16 consumes
+            alignas(32) int16_t pairs[kDctBlock / 2][kDctTerms][2];
+        };
+
+        const DctTable &dctTable() {
+            static const DctTable table = [] {
+                DctTable t{};
+                for (int u = 0; u < kDctTerms; u++) {
+                    const double scale = u == 0 ? std::numbers::sqrt2 / 2 : 1.0;
+                    for (int x = 0; x < kDctBlock; x++) {
+                        const double basis = std::cos((2 * x + 1) * u * std::numbers::pi / (2 * kDctBlock));
+                        t.rows[u][x] = static_cast<int32_t>(std::lround(scale * basis * (1 << kBasisShift)));
+                        t.pairs[x / 2][u][x % 2] = static_cast<int16_t>(t.rows[u][x]);
+                    }
+                }
+                return t;
+            }();
+            return table;
+        }
+    }
+
+    namespace scalar {
+        void dctLowFrequency(const uint8_t *block, const int stride, int32_t *dest) {
+            const DctTable &table = dctTable();
+
+            // Rows first: the lowest kDctTerms frequencies of every row, back to Q0
+            int32_t horizontal[kDctBlock][kDctTerms];
+            for (int y = 0; y < kDctBlock; y++) {
+                const uint8_t *row = block + static_cast<std::ptrdiff_t>(y) * stride;
+                for (int u = 0; u < kDctTerms; u++) {
+                    int32_t sum = 0;
+                    for (int x = 0; x < kDctBlock; x++) {
+                        sum += table.rows[u][x] * row[x];
+                    }
+                    horizontal[y][u] = (sum + kRound) >> kBasisShift;
+                }
+            }
+
+            for (int v = 0; v < kDctTerms; v++) {
+                for (int u = 0; u < kDctTerms; u++) {
+                    int32_t sum = 0;
+                    for (int y = 0; y < kDctBlock; y++) {
+                        sum += table.rows[v][y] * horizontal[y][u];
+                    }
+                    dest[v * kDctTerms + u] = sum;
+                }
+            }
+        }
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        // One 32-bit lane per horizontal frequency u (kDctTerms == 8 lanes)
+        ENGINE_TARGET_AVX2 void dctLowFrequency(const uint8_t *block, const int stride, int32_t *dest) {
+            const DctTable &table = dctTable();
+            const __m256i round = _mm256_set1_epi32(kRound);
+
+            __m256i horizontal[kDctBlock];
+            for (int y = 0; y < kDctBlock; y++) {
+                const uint8_t *row = block + static_cast<std::ptrdiff_t>(y) * stride;
+                __m256i sum = _mm256_setzero_si256();
+                // Two pixels per multiply-add: both broadcast as a 16-bit pair against their basis pair
+                for (int p = 0; p < kDctBlock / 2; p++) {
+                    const __m256i pixels = _mm256_set1_epi32(row[2 * p] | (row[2 * p + 1] << 16));
+                    const __m256i basis = _mm256_load_si256(reinterpret_cast<const __m256i *>(table.pairs[p]));
+                    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(pixels, basis));
+                }
+                horizontal[y] = _mm256_srai_epi32(_mm256_add_epi32(sum, round), kBasisShift);
+            }
+
+            for (int v = 0; v < kDctTerms; v++) {
+                __m256i sum = _mm256_setzero_si256();
+                for (int y = 0; y < kDctBlock; y++) {
+                    sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_set1_epi32(table.rows[v][y]), horizontal[y]));
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + v * kDctTerms), sum);
+            }
+        }
+    }
+#endif
+
+    void dctLowFrequency(const uint8_t *block, const int stride, int32_t *dest) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::dctLowFrequency(block, stride, dest);
+#endif
+        scalar::dctLowFrequency(block, stride, dest);
+    }
+}
@@ -0,0 +1,163 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_KERNELS_H
+#define ENGINE_KERNELS_H
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "backend/cpu/Simd.h"
+
+// Row kernels shared by the engine operations. Each kernel has a scalar reference version and,
+// where it pays off, an AVX2 version that must produce bit-identical output. The unqualified
+// entry points dispatch on simdLevel().
+namespace engine::cpu {
+    // Working set one band (or tile) of a frame operation should fit in: a typical L2
+    inline constexpr int kTileBytes = 256 * 1024;
+
+    // Rows per band, i.e. the parallelFor grain, when each row of the band touches rowBytes in total
+    // (every frame, history or scratch row it reads or writes); at least 8
+    inline int bandRows(const int rowBytes) {
+        return std::max(8, kTileBytes / std::max(rowBytes, 1));
+    }
+
+    // Longest filter weightedSum accepts
+    inline constexpr int kMaxTaps = 63;
+
+    // Most history frames temporalBlend accepts
+    inline constexpr int kMaxHistory = 16;
+
+    // dctLowFrequency: block size and frequencies kept per axis
+    inline constexpr int kDctBlock = 32;
+    inline constexpr int kDctTerms = 8;
+
+    namespace scalar {
+        uint64_t sad(const uint8_t *a, const uint8_t *b, int count);
+
+        void histogram(const uint8_t *src, int count, uint32_t *bins);
+
+        void lumaFromRGB(const uint8_t *src, int bytesPerPixel, uint8_t *dest, int count);
+
+        void weightedSum(const uint8_t *const *sources, const uint16_t *weights, int taps, uint8_t *dest, int count);
+
+        void unsharp(const uint8_t *src, const uint8_t *blurred, int amountQ4, uint8_t *dest, int count);
+
+        void sobel(const uint8_t *above, const uint8_t *row, const uint8_t *below, uint8_t *dest, int count);
+
+        void temporalBlend(const uint8_t *current, const uint8_t *const *history, int historyCount, int threshold,
+                           uint8_t *dest, int count);
+
+        void grayInPlace(uint8_t *row, int bytesPerPixel, int count);
+
+        void rgbToRgba(const uint8_t *src, uint8_t *dest, int count);
+
+        void rgbaToRgb(const uint8_t *src, uint8_t *dest, int count);
+
+        void grayToRgb(const uint8_t *src, int destBytesPerPixel, uint8_t *dest, int count);
+
+        void resizeRow(const uint8_t *src, int bytesPerPixel, const int32_t *offsets, const uint16_t *weights,
+                       uint8_t *dest, int count);
+
+        void premultiply(const uint8_t *src, uint8_t *dest, int count);
+
+        void blendPremultiplied(const uint8_t *overlay, uint8_t *base, int baseBytesPerPixel, int count);
+
+        void dctLowFrequency(const uint8_t *block, int stride, int32_t *dest);
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        uint64_t sad(const uint8_t *a, const uint8_t *b, int count);
+
+        void lumaFromRGB(const uint8_t *src, int bytesPerPixel, uint8_t *dest, int count);
+
+        void weightedSum(const uint8_t *const *sources, const uint16_t *weights, int taps, uint8_t *dest, int count);
+
+        void unsharp(const uint8_t *src, const uint8_t *blurred, int amountQ4, uint8_t *dest, int count);
+
+        void sobel(const uint8_t *above, const uint8_t *row, const uint8_t *below, uint8_t *dest, int count);
+
+        void temporalBlend(const uint8_t *current, const uint8_t *const *history, int historyCount, int threshold,
+                           uint8_t *dest, int count);
+
+        void grayInPlace(uint8_t *row, int bytesPerPixel, int count);
+
+        void rgbToRgba(const uint8_t *src, uint8_t *dest, int count);
+
+        void rgbaToRgb(const uint8_t *src, uint8_t *dest, int count);
+
+        void grayToRgb(const uint8_t *src, int destBytesPerPixel, uint8_t *dest, int count);
+
+        void resizeRow(const uint8_t *src, int bytesPerPixel, const int32_t *offsets, const uint16_t *weights,
+                       uint8_t *dest, int count);
+
+        void premultiply(const uint8_t *src, uint8_t *dest, int count);
+
+        void blendPremultiplied(const uint8_t *overlay, uint8_t *base, int baseBytesPerPixel, int count);
+
+        void dctLowFrequency(const uint8_t *block, int stride, int32_t *dest);
+    }
+#endif
+
+    // Sum of absolute differences between two byte rows
+    uint64_t sad(const uint8_t *a, const uint8_t *b, int count);
+
+    // Accumulates 256 bins (bins must be zeroed by the caller)
+    void histogram(const uint8_t *src, int count, uint32_t *bins);
+
+    // BT.601 luma in 8-bit fixed point: (77 R + 150 G + 29 B + 128) >> 8
+    void lumaFromRGB(const uint8_t *src, int bytesPerPixel, uint8_t *dest, int count);
+
+    // dest[i] = (sum of weights[k] * sources[k][i] + 128) >> 8, weights in Q8 summing to 256.
+    // Serves both passes of a separable filter: shifted pointers into one padded row (horizontal)
+    // or pointers to neighbouring rows (vertical).
+    void weightedSum(const uint8_t *const *sources, const uint16_t *weights, int taps, uint8_t *dest, int count);
+
+    // dest = clamp(src + ((src - blurred) * amountQ4 + 8) >> 4), amountQ4 in [0, 128]
+    void unsharp(const uint8_t *src, const uint8_t *blurred, int amountQ4, uint8_t *dest, int count);
+
+    // Sobel magnitude min(255, |gx| + |gy|) of one row. The three rows must be readable at [-1, count].
+    void sobel(const uint8_t *above, const uint8_t *row, const uint8_t *below, uint8_t *dest, int count);
+
+    // Motion-adaptive temporal average. Each history sample weighs max(0, threshold - |h - c|),
+    // the current sample weighs threshold: dest = round(sum(w * v) / sum(w)) in float.
+    void temporalBlend(const uint8_t *current, const uint8_t *const *history, int historyCount, int threshold,
+                       uint8_t *dest, int count);
+
+    // Replaces R, G and B with the fixed-point luma (see lumaFromRGB), alpha untouched
+    void grayInPlace(uint8_t *row, int bytesPerPixel, int count);
+
+    // Opaque alpha added
+    void rgbToRgba(const uint8_t *src, uint8_t *dest, int count);
+
+    void rgbaToRgb(const uint8_t *src, uint8_t *dest, int count);
+
+    // GRAY8 to RGB24 (destBytesPerPixel 3) or RGBA32 (4, opaque)
+    void grayToRgb(const uint8_t *src, int destBytesPerPixel, uint8_t *dest, int count);
+
+    // Horizontal bilinear: dest pixel x = lerp(src[offsets[x]], next pixel, weights[x] / 256).
+    // Offsets (in bytes) must not decrease along the row; weights are in [0, 256].
+    void resizeRow(const uint8_t *src, int bytesPerPixel, const int32_t *offsets, const uint16_t *weights,
+                   uint8_t *dest, int count);
+
+    // Straight-alpha RGBA32 to premultiplied: color = (color * a) / 255, rounded, alpha kept
+    void premultiply(const uint8_t *src, uint8_t *dest, int count);
+
+    // Premultiplied RGBA32 overlay over an RGB24 or RGBA32 row: o + (b * (255 - a)) / 255, rounded.
+    // The base alpha is kept. Transparent overlay pixels leave the base exactly as it was.
+    void blendPremultiplied(const uint8_t *overlay, uint8_t *base, int baseBytesPerPixel, int count);
+
+    // Lowest kDctTerms x kDctTerms frequencies of the 2-D DCT-II of a kDctBlock x kDctBlock byte block,
+    // dest[v * kDctTerms + u] for vertical frequency v and horizontal u. Fixed point, proportional to
+    // the orthonormal transform.
+    void dctLowFrequency(const uint8_t *block, int stride, int32_t *dest);
+
+    // Copies a row into dest with `radius` replicated edge pixels on both sides
+    void padRow(const uint8_t *src, int width, int bytesPerPixel, int radius, uint8_t *dest);
+}
+
+#endif //ENGINE_KERNELS_H
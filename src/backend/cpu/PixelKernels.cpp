@@ -0,0 +1,254 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <cstring>
+
+#include "backend/cpu/Kernels.h"
+
+namespace engine::cpu {
+    namespace scalar {
+        void grayInPlace(uint8_t *row, const int bytesPerPixel, const int count) {
+            for (int x = 0; x < count; x++) {
+                uint8_t *p = row + x * bytesPerPixel;
+                const auto y = static_cast<uint8_t>((77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8);
+                p[0] = y;
+                p[1] = y;
+                p[2] = y;
+            }
+        }
+
+        void rgbToRgba(const uint8_t *src, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                dest[x * 4 + 0] = src[x * 3 + 0];
+                dest[x * 4 + 1] = src[x * 3 + 1];
+                dest[x * 4 + 2] = src[x * 3 + 2];
+                dest[x * 4 + 3] = 255;
+            }
+        }
+
+        void rgbaToRgb(const uint8_t *src, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                dest[x * 3 + 0] = src[x * 4 + 0];
+                dest[x * 3 + 1] = src[x * 4 + 1];
+                dest[x * 3 + 2] = src[x * 4 + 2];
+            }
+        }
+
+        void grayToRgb(const uint8_t *src, const int destBytesPerPixel, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                uint8_t *p = dest + x * destBytesPerPixel;
+                p[0] = src[x];
+                p[1] = src[x];
+                p[2] = src[x];
+                if (destBytesPerPixel == 4) p[3] = 255;
+            }
+        }
+
+        void resizeRow(const uint8_t *src, const int bytesPerPixel, const int32_t *offsets, const uint16_t *weights,
+                       uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                const uint8_t *left = src + offsets[x];
+                const uint8_t *right = left + bytesPerPixel;
+                const uint32_t w = weights[x];
+                for (int c = 0; c < bytesPerPixel; c++) {
+                    dest[x * bytesPerPixel + c] = static_cast<uint8_t>((left[c] * (256 - w) + right[c] * w + 128) >> 8);
+                }
+            }
+        }
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        namespace {
+            // Stores the low three bytes of each 32-bit lane: 8 RGB24 pixels, exactly 24 bytes
+            ENGINE_TARGET_AVX2 inline void storeRgb8(uint8_t *dest, const __m256i pixels) {
+                const __m256i drop = _mm256_setr_epi8(
+                    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                    0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+                const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(pixels, drop),
+                                                                   _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dest), _mm256_castsi256_si128(packed));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dest + 16), _mm256_extracti128_si256(packed, 1));
+            }
+
+            // (l * (256 - w) + r * w + 128) >> 8 on 16-bit lanes
+            ENGINE_TARGET_AVX2 inline __m256i lerp16(const __m256i l, const __m256i r, const __m256i w) {
+                const __m256i sum = _mm256_add_epi16(_mm256_mullo_epi16(l, _mm256_sub_epi16(_mm256_set1_epi16(256), w)),
+                                                     _mm256_mullo_epi16(r, w));
+                return _mm256_srli_epi16(_mm256_add_epi16(sum, _mm256_set1_epi16(128)), 8);
+            }
+        }
+
+        ENGINE_TARGET_AVX2 void grayInPlace(uint8_t *row, const int bytesPerPixel, const int count) {
+            if (bytesPerPixel != 4) {
+                scalar::grayInPlace(row, bytesPerPixel, count);
+                return;
+            }
+
+            const __m256i mask = _mm256_set1_epi32(0xFF);
+            const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+            const __m256i cr = _mm256_set1_epi32(77), cg = _mm256_set1_epi32(150), cb = _mm256_set1_epi32(29);
+            const __m256i round = _mm256_set1_epi32(128);
+            const __m256i spread = _mm256_set1_epi32(0x010101);
+
+            int x = 0;
+            for (; x + 8 <= count; x += 8) {
+                auto *p = reinterpret_cast<__m256i *>(row + x * 4);
+                const __m256i v = _mm256_loadu_si256(p);
+                const __m256i r = _mm256_and_si256(v, mask);
+                const __m256i g = _mm256_and_si256(_mm256_srli_epi32(v, 8), mask);
+                const __m256i b = _mm256_and_si256(_mm256_srli_epi32(v, 16), mask);
+                __m256i y = _mm256_add_epi32(_mm256_mullo_epi32(r, cr), _mm256_mullo_epi32(g, cg));
+                y = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(y, _mm256_mullo_epi32(b, cb)), round), 8);
+                const __m256i out = _mm256_or_si256(_mm256_and_si256(v, alphaMask), _mm256_mullo_epi32(y, spread));
+                _mm256_storeu_si256(p, out);
+            }
+            scalar::grayInPlace(row + x * 4, 4, count - x);
+        }
+
+        ENGINE_TARGET_AVX2 void rgbToRgba(const uint8_t *src, uint8_t *dest, const int count) {
+            // Each 128-bit lane turns 4 RGB pixels (12 of its 16 loaded bytes) into 4 RGBA pixels
+            const __m256i shuffle = _mm256_setr_epi8(
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+            int x = 0;
+            // The second lane loads 16 bytes from pixel x + 4, i.e. up to byte 3 * x + 28
+            for (; x + 10 <= count; x += 8) {
+                const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 3));
+                const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * 3 + 12));
+                const __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+                const __m256i out = _mm256_or_si256(_mm256_shuffle_epi8(v, shuffle), alpha);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x * 4), out);
+            }
+            scalar::rgbToRgba(src + x * 3, dest + x * 4, count - x);
+        }
+
+        ENGINE_TARGET_AVX2 void rgbaToRgb(const uint8_t *src, uint8_t *dest, const int count) {
+            int x = 0;
+            for (; x + 8 <= count; x += 8) {
+                storeRgb8(dest + x * 3, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x * 4)));
+            }
+            scalar::rgbaToRgb(src + x * 4, dest + x * 3, count - x);
+        }
+
+        ENGINE_TARGET_AVX2 void grayToRgb(const uint8_t *src, const int destBytesPerPixel, uint8_t *dest,
+                                          const int count) {
+            const __m256i spread = _mm256_set1_epi32(0x010101);
+            const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+
+            int x = 0;
+            for (; x + 8 <= count; x += 8) {
+                const __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + x)));
+                const __m256i rgb = _mm256_mullo_epi32(v, spread);
+                if (destBytesPerPixel == 4) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x * 4), _mm256_or_si256(rgb, alpha));
+                } else {
+                    storeRgb8(dest + x * 3, rgb);
+                }
+            }
+            scalar::grayToRgb(src + x, destBytesPerPixel, dest + x * destBytesPerPixel, count - x);
+        }
+
+        ENGINE_TARGET_AVX2 void resizeRow(const uint8_t *src, const int bytesPerPixel, const int32_t *offsets,
+                                          const uint16_t *weights, uint8_t *dest, const int count) {
+            int x = 0;
+            if (count > 0) {
+                // Pixels are gathered as 4 bytes: stay below the last byte the row reads (offsets ascend)
+                const int32_t end = offsets[count - 1] + 2 * bytesPerPixel;
+                const auto *base = reinterpret_cast<const int *>(src);
+                if (bytesPerPixel == 1) {
+                    // One gather holds left in byte 0 and right in byte 1; spread to 16-bit lanes, they are
+                    // weighed by (256 - w, w) in one madd
+                    const __m256i spread = _mm256_setr_epi8(
+                        0, -1, 1, -1, 4, -1, 5, -1, 8, -1, 9, -1, 12, -1, 13, -1,
+                        0, -1, 1, -1, 4, -1, 5, -1, 8, -1, 9, -1, 12, -1, 13, -1);
+                    for (; x + 8 <= count && offsets[x + 7] + 4 <= end; x += 8) {
+                        const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(offsets + x));
+                        const __m256i pair = _mm256_shuffle_epi8(_mm256_i32gather_epi32(base, index, 1), spread);
+                        const __m256i w = _mm256_cvtepu16_epi32(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + x)));
+                        const __m256i wPair = _mm256_or_si256(_mm256_sub_epi32(_mm256_set1_epi32(256), w),
+                                                              _mm256_slli_epi32(w, 16));
+                        const __m256i sum = _mm256_add_epi32(_mm256_madd_epi16(pair, wPair), _mm256_set1_epi32(128));
+                        const __m256i words = _mm256_permute4x64_epi64(
+                            _mm256_packus_epi32(_mm256_srli_epi32(sum, 8), _mm256_setzero_si256()), 0x08);
+                        const __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(words), _mm_setzero_si128());
+                        _mm_storel_epi64(reinterpret_cast<__m128i *>(dest + x), bytes);
+                    }
+                } else if (bytesPerPixel == 3 || bytesPerPixel == 4) {
+                    const auto *next = reinterpret_cast<const int *>(src + bytesPerPixel);
+                    const __m256i zero = _mm256_setzero_si256();
+                    for (; x + 8 <= count && offsets[x + 7] + bytesPerPixel + 4 <= end; x += 8) {
+                        const __m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(offsets + x));
+                        const __m256i left = _mm256_i32gather_epi32(base, index, 1);
+                        const __m256i right = _mm256_i32gather_epi32(next, index, 1);
+                        // Each pixel's weight in all four of its 16-bit channel lanes: pixels 0, 1, 4, 5 and 2, 3, 6, 7
+                        const __m256i w = _mm256_cvtepu16_epi32(
+                            _mm_loadu_si128(reinterpret_cast<const __m128i *>(weights + x)));
+                        const __m256i w2 = _mm256_or_si256(w, _mm256_slli_epi32(w, 16));
+                        const __m256i lo = lerp16(_mm256_unpacklo_epi8(left, zero), _mm256_unpacklo_epi8(right, zero),
+                                                  _mm256_unpacklo_epi32(w2, w2));
+                        const __m256i hi = lerp16(_mm256_unpackhi_epi8(left, zero), _mm256_unpackhi_epi8(right, zero),
+                                                  _mm256_unpackhi_epi32(w2, w2));
+                        const __m256i out = _mm256_packus_epi16(lo, hi);
+                        if (bytesPerPixel == 4) {
+                            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + x * 4), out);
+                        } else {
+                            storeRgb8(dest + x * 3, out);
+                        }
+                    }
+                }
+            }
+            scalar::resizeRow(src, bytesPerPixel, offsets + x, weights + x, dest + x * bytesPerPixel, count - x);
+        }
+    }
+#endif
+
+    void grayInPlace(uint8_t *row, const int bytesPerPixel, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::grayInPlace(row, bytesPerPixel, count);
+#endif
+        scalar::grayInPlace(row, bytesPerPixel, count);
+    }
+
+    void rgbToRgba(const uint8_t *src, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::rgbToRgba(src, dest, count);
+#endif
+        scalar::rgbToRgba(src, dest, count);
+    }
+
+    void rgbaToRgb(const uint8_t *src, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::rgbaToRgb(src, dest, count);
+#endif
+        scalar::rgbaToRgb(src, dest, count);
+    }
+
+    void grayToRgb(const uint8_t *src, const int destBytesPerPixel, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::grayToRgb(src, destBytesPerPixel, dest, count);
+#endif
+        scalar::grayToRgb(src, destBytesPerPixel, dest, count);
+    }
+
+    void resizeRow(const uint8_t *src, const int bytesPerPixel, const int32_t *offsets, const uint16_t *weights,
+                   uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) return avx2::resizeRow(src, bytesPerPixel, offsets, weights, dest, count);
+#endif
+        scalar::resizeRow(src, bytesPerPixel, offsets, weights, dest, count);
+    }
+
+    void padRow(const uint8_t *src, const int width, const int bytesPerPixel, const int radius, uint8_t *dest) {
+        const int rowBytes = width * bytesPerPixel;
+        std::memcpy(dest + radius * bytesPerPixel, src, rowBytes);
+        for (int i = 0; i < radius; i++) {
+            std::memcpy(dest + i * bytesPerPixel, src, bytesPerPixel);
+            std::memcpy(dest + (radius + width + i) * bytesPerPixel, src + rowBytes - bytesPerPixel, bytesPerPixel);
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_SIMD_H
+#define ENGINE_SIMD_H
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ENGINE_X86 1
+#include <immintrin.h>
+#endif
+
+// AVX2 kernels are compiled per function so the rest of the library keeps the baseline ISA
+// and the choice is made at runtime.
+#if defined(ENGINE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define ENGINE_HAS_AVX2 1
+#define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(ENGINE_X86) && defined(_MSC_VER)
+#define ENGINE_HAS_AVX2 1
+#define ENGINE_TARGET_AVX2
+#include <intrin.h>
+#endif
+
+namespace engine::cpu {
+    enum class SimdLevel {
+        Scalar,
+        AVX2
+    };
+
+    // Best level supported by this CPU and OS
+    inline SimdLevel detectSimdLevel() {
+#if defined(ENGINE_HAS_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::AVX2 : SimdLevel::Scalar;
+#elif defined(ENGINE_HAS_AVX2)
+        int info[4];
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return SimdLevel::Scalar;
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) ? SimdLevel::AVX2 : SimdLevel::Scalar;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    namespace detail {
+        inline std::atomic<SimdLevel> &activeSimdLevel() {
+            static std::atomic<SimdLevel> level{detectSimdLevel()};
+            return level;
+        }
+    }
+
+    // Level the kernel entry points dispatch to
+    inline SimdLevel simdLevel() {
+        return detail::activeSimdLevel().load(std::memory_order_relaxed);
+    }
+
+    // Caps the dispatch level (A/B runs, config overrides); never above what the CPU supports
+    inline void setSimdLevel(const SimdLevel level) {
+        detail::activeSimdLevel().store(std::min(level, detectSimdLevel()), std::memory_order_relaxed);
+    }
+}
+
+#endif //ENGINE_SIMD_H
@@ -0,0 +1,87 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "backend/cpu/Kernels.h"
+
+namespace engine::cpu {
+    namespace scalar {
+        void temporalBlend(const uint8_t *current, const uint8_t *const *history, const int historyCount,
+                           const int threshold, uint8_t *dest, const int count) {
+            for (int x = 0; x < count; x++) {
+                const int c = current[x];
+                int numerator = c * threshold;
+                int denominator = threshold;
+                for (int k = 0; k < historyCount; k++) {
+                    const int h = history[k][x];
+                    const int weight = std::max(0, threshold - std::abs(h - c));
+                    numerator += weight * h;
+                    denominator += weight;
+                }
+                // Same float ops as the AVX2 path, so both round identically
+                const float value = static_cast<float>(numerator) / static_cast<float>(denominator) + 0.5f;
+                dest[x] = static_cast<uint8_t>(static_cast<int>(value));
+            }
+        }
+    }
+
+#ifdef ENGINE_HAS_AVX2
+    namespace avx2 {
+        ENGINE_TARGET_AVX2 void temporalBlend(const uint8_t *current, const uint8_t *const *history,
+                                              const int historyCount, const int threshold, uint8_t *dest,
+                                              const int count) {
+            const __m256i limit = _mm256_set1_epi32(threshold);
+            const __m256i zero = _mm256_setzero_si256();
+            const __m256 half = _mm256_set1_ps(0.5f);
+
+            int x = 0;
+            for (; x + 8 <= count; x += 8) {
+                const __m256i c = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(current + x)));
+                __m256i numerator = _mm256_mullo_epi32(c, limit);
+                __m256i denominator = limit;
+
+                for (int k = 0; k < historyCount; k++) {
+                    const __m256i h = _mm256_cvtepu8_epi32(
+                        _mm_loadl_epi64(reinterpret_cast<const __m128i *>(history[k] + x)));
+                    const __m256i weight = _mm256_max_epi32(
+                        _mm256_sub_epi32(limit, _mm256_abs_epi32(_mm256_sub_epi32(h, c))), zero);
+                    numerator = _mm256_add_epi32(numerator, _mm256_mullo_epi32(weight, h));
+                    denominator = _mm256_add_epi32(denominator, weight);
+                }
+
+                const __m256 value = _mm256_add_ps(
+                    _mm256_div_ps(_mm256_cvtepi32_ps(numerator), _mm256_cvtepi32_ps(denominator)), half);
+                const __m256i result = _mm256_cvttps_epi32(value);
+
+                // 8 x int32 -> 8 bytes (values are already in [0, 255])
+                const __m256i words = _mm256_packus_epi32(result, result);
+                const __m256i bytes = _mm256_packus_epi16(words, words);
+                const __m128i packed = _mm_unpacklo_epi32(_mm256_castsi256_si128(bytes),
+                                                          _mm256_extracti128_si256(bytes, 1));
+                _mm_storel_epi64(reinterpret_cast<__m128i *>(dest + x), packed);
+            }
+
+            if (x < count) {
+                const uint8_t *tail[kMaxHistory];
+                for (int k = 0; k < historyCount; k++) {
+                    tail[k] = history[k] + x;
+                }
+                scalar::temporalBlend(current + x, tail, historyCount, threshold, dest + x, count - x);
+            }
+        }
+    }
+#endif
+
+    void temporalBlend(const uint8_t *current, const uint8_t *const *history, const int historyCount,
+                       const int threshold, uint8_t *dest, const int count) {
+#ifdef ENGINE_HAS_AVX2
+        if (simdLevel() == SimdLevel::AVX2) {
+            return avx2::temporalBlend(current, history, historyCount, threshold, dest, count);
+        }
+#endif
+        scalar::temporalBlend(current, history, historyCount, threshold, dest, count);
+    }
+}
@@ -8,15 +8,79 @@ extern "C" {
 #include <libswscale/swscale.h>
 }
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 #include "io/Decoder.h"
+#include "io/FrameCache.h"
+#include "io/InputSource.h"
 #include "utils/Logger.h"
+#include "utils/Timer.h"
 
 namespace logger = engine::utils::Logger;
 
 namespace engine::io {
-    Decoder::Decoder() {
+    namespace {
+        AVPixelFormat toAVPixelFormat(const PixelFormat format) {
+            switch (format) {
+                case PixelFormat::RGB24: return AV_PIX_FMT_RGB24;
+                case PixelFormat::RGBA32: return AV_PIX_FMT_RGBA;
+                case PixelFormat::GRAY8: return AV_PIX_FMT_GRAY8;
+                default: return AV_PIX_FMT_NONE;
+            }
+        }
+
+        int toSwsFlags(const ScalerAlgorithm scaler) {
+            switch (scaler) {
+                case ScalerAlgorithm::FastBilinear: return SWS_FAST_BILINEAR;
+                case ScalerAlgorithm::Bicubic: return SWS_BICUBIC;
+                case ScalerAlgorithm::Area: return SWS_AREA;
+                case ScalerAlgorithm::Point: return SWS_POINT;
+                case ScalerAlgorithm::Lanczos: return SWS_LANCZOS;
+                default: return SWS_BILINEAR;
+            }
+        }
+
+        // Demuxer options for live input: read only what is needed to find the codec parameters. The few
+        // packets read while probing stay buffered (no "nobuffer" flag), otherwise the first keyframe is
+        // lost and the picture stays broken until the next one.
+        AVDictionary *openOptions(const bool lowLatency) {
+            AVDictionary *options = nullptr;
+            if (lowLatency) {
+                av_dict_set(&options, "probesize", "32", 0);
+                av_dict_set(&options, "analyzeduration", "0", 0);
+                av_dict_set(&options, "fpsprobesize", "0", 0);
+            }
+            return options;
+        }
+
+        int interruptRequested(void *opaque) {
+            return static_cast<const std::atomic<bool> *>(opaque)->load(std::memory_order_relaxed) ? 1 : 0;
+        }
+
+        int readSource(void *opaque, uint8_t *buffer, const int size) {
+            const int count = static_cast<InputSource *>(opaque)->read(buffer, size);
+            if (count == 0) return AVERROR_EOF;
+            return count < 0 ? AVERROR(EIO) : count;
+        }
+
+        int64_t seekSource(void *opaque, const int64_t offset, const int whence) {
+            auto *source = static_cast<InputSource *>(opaque);
+            if (whence & AVSEEK_SIZE) {
+                return source->size();
+            }
+            const int64_t position = source->seek(offset, whence & ~AVSEEK_FORCE);
+            return position < 0 ? AVERROR(EIO) : position;
+        }
+    }
+
+    Decoder::Decoder() : Decoder(engine::Config::current()) {
+    }
+
+    Decoder::Decoder(const engine::Config &config)
+        : ioBufferSize(config.ioBufferSize), scaleFlags(toSwsFlags(config.scaler)),
+          decoderThreads(config.decoderThreads), lowLatency(config.lowLatency) {
         formatCtx = avformat_alloc_context();
         avFrame = av_frame_alloc();
         avPacket = av_packet_alloc();
@@ -50,11 +114,80 @@ namespace engine::io {
     }
 
     void Decoder::open(const std::string &filepath) {
-        if (avformat_open_input(&formatCtx, filepath.c_str(), nullptr, nullptr) != 0) {
+        interrupted = false;
+        if (!formatCtx) {
+            formatCtx = avformat_alloc_context();
+        }
+        if (!formatCtx) {
+            logger::error("Decoder::open: Could not allocate memory for AVFormatContext");
+            throw std::runtime_error("Decoder::open: Could not allocate memory for AVFormatContext");
+        }
+        formatCtx->interrupt_callback = {interruptRequested, &interrupted};
+
+        AVDictionary *options = openOptions(lowLatency);
+        const int opened = avformat_open_input(&formatCtx, filepath.c_str(), nullptr, &options);
+        av_dict_free(&options);
+        if (opened != 0) {
             logger::error("Decoder::open: Could not open file: {}", filepath);
             throw std::runtime_error("Decoder::open: Could not open file: " + filepath);
         }
 
+        openStreams();
+        sourcePath = filepath;
+        sourceIdentity = frameCache ? FrameCache::fileIdentity(filepath) : std::string();
+    }
+
+    void Decoder::open(std::shared_ptr<InputSource> source) {
+        if (!source) {
+            logger::error("Decoder::open: null input source");
+            throw std::runtime_error("Decoder::open: null input source");
+        }
+
+        auto *buffer = static_cast<unsigned char *>(av_malloc(ioBufferSize));
+        ioCtx = buffer ? avio_alloc_context(buffer, ioBufferSize, 0, source.get(), readSource, nullptr,
+                                            source->seekable() ? seekSource : nullptr)
+                       : nullptr;
+        if (!ioCtx) {
+            av_free(buffer);
+            logger::error("Decoder::open: Could not allocate AVIOContext");
+            throw std::runtime_error("Decoder::open: Could not allocate AVIOContext");
+        }
+        inputSource = std::move(source);
+
+        if (!formatCtx) {
+            formatCtx = avformat_alloc_context();
+        }
+        if (!formatCtx) {
+            close();
+            logger::error("Decoder::open: Could not allocate memory for AVFormatContext");
+            throw std::runtime_error("Decoder::open: Could not allocate memory for AVFormatContext");
+        }
+        formatCtx->pb = ioCtx;
+        formatCtx->flags |= AVFMT_FLAG_CUSTOM_IO;
+        interrupted = false;
+        formatCtx->interrupt_callback = {interruptRequested, &interrupted};
+
+        const std::string name = inputSource->name();
+        // The name only serves as a probing hint here, all data comes from the source
+        AVDictionary *options = openOptions(lowLatency);
+        const int opened = avformat_open_input(&formatCtx, name.c_str(), nullptr, &options);
+        av_dict_free(&options);
+        if (opened != 0) {
+            close();
+            logger::error("Decoder::open: Could not open input: {}", name);
+            throw std::runtime_error("Decoder::open: Could not open input: " + name);
+        }
+
+        openStreams();
+        sourcePath.clear();
+        sourceIdentity = inputSource->identity();
+    }
+
+    void Decoder::setIOBufferSize(const int bytes) {
+        ioBufferSize = std::max(bytes, 4096);
+    }
+
+    void Decoder::openStreams() {
         if (avformat_find_stream_info(formatCtx, nullptr) < 0) {
             logger::error("Decoder::open: Could not find stream information");
             throw std::runtime_error("Decoder::open: Could not find stream information");
@@ -79,10 +212,46 @@ namespace engine::io {
             throw std::runtime_error("Decoder::open: Could not copy codec parameters");
         }
 
+        if (decoderThreads > 0) {
+            codecCtx->thread_count = decoderThreads;
+        }
+        if (keyframesOnly || lowLatency) {
+            // Frame threading delays output by one frame per thread, which would skip keyframes after a seek
+            // and adds that many frame intervals of latency on live input
+            codecCtx->thread_type = FF_THREAD_SLICE;
+        }
+        if (keyframesOnly) {
+            codecCtx->skip_frame = AVDISCARD_NONKEY;
+        }
+        if (lowLatency) {
+            codecCtx->flags |= AV_CODEC_FLAG_LOW_DELAY;
+            codecCtx->flags2 |= AV_CODEC_FLAG2_FAST;
+        }
+
+        // Let codecs that support it (MJPEG, ...) decode at 1/2, 1/4 or 1/8 size when that still covers the hint
+        if (hintWidth > 0 && hintHeight > 0) {
+            int lowres = 0;
+            while (lowres < codec->max_lowres &&
+                   (codecCtx->width >> (lowres + 1)) >= hintWidth &&
+                   (codecCtx->height >> (lowres + 1)) >= hintHeight) {
+                lowres++;
+            }
+            codecCtx->lowres = lowres;
+        }
+
         if (avcodec_open2(codecCtx, codec, nullptr) < 0) {
             logger::error("Decoder::open: Could not open video codec");
             throw std::runtime_error("Decoder::open: Could not open video codec");
         }
+
+        draining = false;
+        lastPts = 0;
+        corruptPackets = 0;
+        arrivals.fill({AV_NOPTS_VALUE, 0});
+
+        const AVStream *stream = formatCtx->streams[videoStreamIndex];
+        const double frameSeconds = stream->avg_frame_rate.num > 0 ? 1.0 / av_q2d(stream->avg_frame_rate) : 0;
+        frameDuration = std::max<int64_t>(1, std::llround(frameSeconds / av_q2d(stream->time_base)));
     }
 
     void Decoder::printVideoInfo(const std::string &filepath) {
@@ -116,82 +285,153 @@ namespace engine::io {
             avformat_close_input(&formatCtx);
             formatCtx = nullptr;
         }
+        // avformat_close_input leaves custom I/O to its owner
+        if (ioCtx) {
+            av_freep(&ioCtx->buffer);
+            avio_context_free(&ioCtx);
+        }
+        inputSource.reset();
         videoStreamIndex = -1;
     }
 
-    bool Decoder::readFrame(engine::Frame &outFrame, const AVPixelFormat PixelFormat) {
-        // Keep reading until found a video packet that decodes into a full frame
-        while (av_read_frame(formatCtx, avPacket) >= 0) {
-            // Is this a video packet?
-            if (avPacket->stream_index == videoStreamIndex) {
-                // Send packet to decoder
-                if (avcodec_send_packet(codecCtx, avPacket) < 0) {
-                    logger::error("Decoder::readFrame: Could not send packet");
-                    av_packet_unref(avPacket);
-                    continue;
-                }
+    Expected<void> Decoder::decodeNext() {
+        if (!codecCtx) {
+            return Error{ErrorCode::InvalidState, "Decoder: no video opened"};
+        }
 
-                // Receive frame from decoder
-                // (One packet might generate 0, 1, or more frames)
-                int response = avcodec_receive_frame(codecCtx, avFrame);
-                if (response == AVERROR(EAGAIN) || response == AVERROR_EOF) {
-                    // Not enough data yet, or end of stream
-                    av_packet_unref(avPacket);
-                    continue;
+        while (true) {
+            // Drain frames the decoder already holds before feeding it more packets
+            // (one packet might generate 0, 1, or more frames)
+            const int response = avcodec_receive_frame(codecCtx, avFrame);
+            if (response >= 0) {
+                // Concealed errors: the decoder still returns a picture, with the damage flagged
+                if (!(avFrame->flags & AV_FRAME_FLAG_CORRUPT) && avFrame->decode_error_flags == 0) {
+                    return {};
                 }
-                if (response < 0) {
-                    logger::error("Decoder::readFrame: Error receiving Frame from Decoder");
-                    av_packet_unref(avPacket);
-                    return false;
+                if (!skipCorrupt) {
+                    return Error{ErrorCode::CorruptData, "Decoder: decoded frame is corrupt"};
                 }
-
-                // =========================================================
-                // CONVERSION TIME: YUV -> RGB
-                // =========================================================
-
-                // Initialize the Scaler (SwsContext) if it hasn't been created
-                // or if the Dimensions changed
-                // (Re)initialize the Scaler (SwsContext) using sws_getCachedContext
-                // so it is updated if the dimensions or pixel format change mid-stream.
-
-                swsCtx = sws_getCachedContext(
-                    swsCtx,
-                    codecCtx->width, codecCtx->height, codecCtx->pix_fmt, // Input (video)
-                    outFrame.width, outFrame.height, PixelFormat, // Output (Frame)
-                    SWS_BILINEAR, nullptr, nullptr, nullptr
-                );
-                if (!swsCtx) {
-                    logger::error("Decoder::readFrame: Could not initialize SwsContext");
-                    av_packet_unref(avPacket);
-                    return false;
+                corruptPackets++;
+                logger::warn("Decoder::readFrame: skipping frame the decoder flagged as corrupt");
+                continue;
+            }
+            if (response == AVERROR_EOF) {
+                return Error{ErrorCode::EndOfStream, "Decoder: end of stream", response};
+            }
+            if (response == AVERROR_INVALIDDATA) {
+                if (!skipCorrupt) {
+                    return Error{ErrorCode::CorruptData, "Decoder: corrupt frame", response};
                 }
+                corruptPackets++;
+                logger::warn("Decoder::readFrame: skipping corrupt frame");
+                continue;
+            }
+            if (response != AVERROR(EAGAIN)) {
+                logger::error("Decoder::readFrame: Error receiving Frame from Decoder");
+                return Error{ErrorCode::CorruptData, "Decoder: error receiving frame from decoder", response};
+            }
+            if (draining) {
+                return Error{ErrorCode::EndOfStream, "Decoder: end of stream", AVERROR_EOF};
+            }
 
-                // Prepare destination pointers for sws_scale
-                // Point to row(0) as it's a contiguous block
-                uint8_t *dest[4] = {outFrame.row(0), nullptr, nullptr, nullptr};
-                const int destLineSize[4] = {outFrame.stride, 0, 0, 0}; // 3 bytes per pixel for RGB24
-
-                // Perform the conversion
-                sws_scale(swsCtx,
-                          avFrame->data, avFrame->linesize, // Source (YUV)
-                          0, codecCtx->height, // Source height
-                          dest, destLineSize); // Destination (RGB)
+            if (const int read = av_read_frame(formatCtx, avPacket); read < 0) {
+                if (read == AVERROR(EAGAIN)) {
+                    // Live input with nothing buffered yet
+                    return Error{ErrorCode::TryAgain, "Decoder: no data available yet", read};
+                }
+                if (read == AVERROR_INVALIDDATA) {
+                    // A damaged packet the demuxer could not parse; it resyncs on the next read
+                    if (!skipCorrupt) {
+                        return Error{ErrorCode::CorruptData, "Decoder: corrupt packet", read};
+                    }
+                    corruptPackets++;
+                    logger::warn("Decoder::readFrame: skipping packet the demuxer could not parse");
+                    continue;
+                }
+                if (read != AVERROR_EOF) {
+                    logger::error("Decoder::readFrame: Could not read packet");
+                    return Error{ErrorCode::IOFailure, "Decoder: could not read packet", read};
+                }
+                // End of file: flush the frames still buffered inside the decoder
+                avcodec_send_packet(codecCtx, nullptr);
+                draining = true;
+                continue;
+            }
 
-                // Clean up
+            // Skip packets of other streams, and non-key packets before they reach the decoder
+            if (avPacket->stream_index != videoStreamIndex ||
+                (keyframesOnly && !(avPacket->flags & AV_PKT_FLAG_KEY))) {
                 av_packet_unref(avPacket);
-                return true;
+                continue;
             }
 
-            // Unreferenced packet if it wasn't video
+            const int64_t packetPts = avPacket->pts != AV_NOPTS_VALUE ? avPacket->pts : avPacket->dts;
+            arrivals[nextArrival] = {packetPts, utils::nowNanos()};
+            nextArrival = (nextArrival + 1) % kArrivals;
+
+            const int sent = avcodec_send_packet(codecCtx, avPacket);
             av_packet_unref(avPacket);
+            if (sent < 0) {
+                if (!skipCorrupt) {
+                    return Error{ErrorCode::CorruptData, "Decoder: could not send packet", sent};
+                }
+                corruptPackets++;
+                logger::warn("Decoder::readFrame: skipping packet the decoder rejected");
+            }
         }
+    }
 
-        return false;
+    Expected<void> Decoder::scaleInto(uint8_t *dest, const int destStride, const int destWidth, const int destHeight,
+                                      const AVPixelFormat PixelFormat) {
+        // =========================================================
+        // CONVERSION TIME: YUV -> RGB
+        // =========================================================
+
+        // (Re)initialize the Scaler (SwsContext) using sws_getCachedContext
+        // so it is updated if the dimensions or pixel format change mid-stream.
+        swsCtx = sws_getCachedContext(
+            swsCtx,
+            avFrame->width, avFrame->height, static_cast<AVPixelFormat>(avFrame->format), // Input (video)
+            destWidth, destHeight, PixelFormat, // Output (Frame)
+            scaleFlags, nullptr, nullptr, nullptr
+        );
+        if (!swsCtx) {
+            logger::error("Decoder::readFrame: Could not initialize SwsContext");
+            return Error{ErrorCode::UnsupportedFormat, "Decoder: could not initialize SwsContext"};
+        }
+
+        uint8_t *destData[4] = {dest, nullptr, nullptr, nullptr};
+        const int destLineSize[4] = {destStride, 0, 0, 0};
+
+        // Perform the conversion
+        sws_scale(swsCtx,
+                  avFrame->data, avFrame->linesize, // Source (YUV)
+                  0, avFrame->height, // Source height
+                  destData, destLineSize); // Destination (RGB)
+        return {};
     }
 
-    bool Decoder::readFrame_RGB24(engine::Frame &outFrame) {
+    Expected<void> Decoder::readFrame(engine::Frame &outFrame, const AVPixelFormat PixelFormat) {
         // Keep reading until found a video packet that decodes into a full frame
+        if (auto decoded = decodeNext(); !decoded) {
+            return decoded;
+        }
+        return convertDecoded(outFrame, PixelFormat);
+    }
 
+    Expected<void> Decoder::convertDecoded(engine::Frame &outFrame, const AVPixelFormat PixelFormat) {
+        // Point to row(0) as it's a contiguous block
+        if (auto scaled = scaleInto(outFrame.row(0), outFrame.stride, outFrame.width, outFrame.height, PixelFormat);
+            !scaled) {
+            return scaled;
+        }
+        outFrame.pts = avFrame->best_effort_timestamp;
+        lastPts = outFrame.pts;
+        outFrame.arrival = arrivalOf(outFrame.pts);
+        return {};
+    }
+
+    Expected<void> Decoder::readFrame_RGB24(engine::Frame &outFrame) {
         if (outFrame.pixelFormat != PixelFormat::RGB24) {
             if (outFrame.pixelFormat == PixelFormat::RGBA32) {
                 logger::warn(
@@ -199,78 +439,13 @@ namespace engine::io {
                 return Decoder::readFrame_RGBA32(outFrame);
             }
             logger::error("Decoder::readFrame_RGB24: Could not detect pixel format or pixel format unsupported.");
-            return false;
+            return Error{ErrorCode::UnsupportedFormat, "Decoder::readFrame_RGB24: pixel format unsupported"};
         }
 
-        while (av_read_frame(formatCtx, avPacket) >= 0) {
-            // Is this a video packet?
-            if (avPacket->stream_index == videoStreamIndex) {
-                // Send packet to decoder
-                if (avcodec_send_packet(codecCtx, avPacket) < 0) {
-                    logger::error("Decoder::readFrame: Could not send packet");
-                    av_packet_unref(avPacket);
-                    continue;
-                }
-
-                // Receive frame from decoder
-                // (One packet might generate 0, 1, or more frames)
-                int response = avcodec_receive_frame(codecCtx, avFrame);
-                if (response == AVERROR(EAGAIN) || response == AVERROR_EOF) {
-                    // Not enough data yet, or end of stream
-                    av_packet_unref(avPacket);
-                    continue;
-                }
-                if (response < 0) {
-                    logger::error("Decoder::readFrame: Error receiving Frame from Decoder");
-                    av_packet_unref(avPacket);
-                    return false;
-                }
-
-                // =========================================================
-                // CONVERSION TIME: YUV -> RGB
-                // =========================================================
-
-                // Initialize the Scaler (SwsContext) if it hasn't been created
-                // or if the Dimensions changed
-                // (Re)initialize the Scaler (SwsContext) using sws_getCachedContext
-                // so it is updated if the dimensions or pixel format change mid-stream.
-
-                swsCtx = sws_getCachedContext(
-                    swsCtx,
-                    codecCtx->width, codecCtx->height, codecCtx->pix_fmt, // Input (video)
-                    outFrame.width, outFrame.height, AV_PIX_FMT_RGB24, // Output (Frame)
-                    SWS_BILINEAR, nullptr, nullptr, nullptr
-                );
-                if (!swsCtx) {
-                    logger::error("Decoder::readFrame: Could not initialize SwsContext");
-                    av_packet_unref(avPacket);
-                    return false;
-                }
-
-                // Prepare destination pointers for sws_scale
-                // Point to row(0) as it's a contiguous block
-                uint8_t *dest[4] = {outFrame.row(0), nullptr, nullptr, nullptr};
-                const int destLineSize[4] = {outFrame.stride, 0, 0, 0}; // 3 bytes per pixel for RGB24
-
-                // Perform the conversion
-                sws_scale(swsCtx,
-                          avFrame->data, avFrame->linesize, // Source (YUV)
-                          0, codecCtx->height, // Source height
-                          dest, destLineSize); // Destination (RGB)
-
-                // Clean up
-                av_packet_unref(avPacket);
-                return true;
-            }
-
-            // Unreferenced packet if it wasn't video
-            av_packet_unref(avPacket);
-        }
-
-        return false;
+        return readFrame(outFrame, AV_PIX_FMT_RGB24);
     }
 
-    bool Decoder::readFrame_RGBA32(engine::Frame &outFrame) {
+    Expected<void> Decoder::readFrame_RGBA32(engine::Frame &outFrame) {
         if (outFrame.pixelFormat != PixelFormat::RGBA32) {
             if (outFrame.pixelFormat == PixelFormat::RGB24) {
                 logger::warn(
@@ -278,76 +453,170 @@ namespace engine::io {
                 return Decoder::readFrame_RGB24(outFrame);
             }
             logger::error("Decoder::readFrame_RGBA32: Could not detect pixel format or pixel format unsupported.");
-            return false;
+            return Error{ErrorCode::UnsupportedFormat, "Decoder::readFrame_RGBA32: pixel format unsupported"};
         }
 
-        // Keep reading until found a video packet that decodes into a full frame
-        while (av_read_frame(formatCtx, avPacket) >= 0) {
-            // Is this a video packet?
-            if (avPacket->stream_index == videoStreamIndex) {
-                // Send packet to decoder
-                if (avcodec_send_packet(codecCtx, avPacket) < 0) {
-                    logger::error("Decoder::readFrame: Could not send packet");
-                    av_packet_unref(avPacket);
-                    continue;
-                }
+        return readFrame(outFrame, AV_PIX_FMT_RGBA);
+    }
 
-                // Receive frame from decoder
-                // (One packet might generate 0, 1, or more frames)
-                int response = avcodec_receive_frame(codecCtx, avFrame);
-                if (response == AVERROR(EAGAIN) || response == AVERROR_EOF) {
-                    // Not enough data yet, or end of stream
-                    av_packet_unref(avPacket);
-                    continue;
+    Expected<void> Decoder::readFrameInto(const engine::FrameView dest) {
+        const AVPixelFormat format = toAVPixelFormat(dest.pixelFormat);
+        if (format == AV_PIX_FMT_NONE) {
+            logger::error("Decoder::readFrameInto: pixel format unsupported");
+            return Error{ErrorCode::UnsupportedFormat, "Decoder::readFrameInto: pixel format unsupported"};
+        }
+        if (dest.empty()) {
+            logger::error("Decoder::readFrameInto: empty dest view");
+            return Error{ErrorCode::InvalidArgument, "Decoder::readFrameInto: empty dest view"};
+        }
+
+        if (auto decoded = decodeNext(); !decoded) {
+            return decoded;
+        }
+
+        // Scale straight into the view: parent stride, offset origin
+        if (auto scaled = scaleInto(dest.data, dest.stride, dest.width, dest.height, format); !scaled) {
+            return scaled;
+        }
+        lastPts = avFrame->best_effort_timestamp;
+        return {};
+    }
+
+    Expected<void> Decoder::readFrameAt(const double seconds, engine::Frame &outFrame) {
+        if (!formatCtx || !codecCtx || videoStreamIndex < 0) {
+            logger::error("Decoder::readFrameAt: no video opened");
+            return Error{ErrorCode::InvalidState, "Decoder::readFrameAt: no video opened"};
+        }
+        const AVPixelFormat format = toAVPixelFormat(outFrame.pixelFormat);
+        if (format == AV_PIX_FMT_NONE) {
+            logger::error("Decoder::readFrameAt: pixel format unsupported");
+            return Error{ErrorCode::UnsupportedFormat, "Decoder::readFrameAt: pixel format unsupported"};
+        }
+
+        const int64_t target = toPts(seconds);
+        if (frameCache) {
+            const FrameKey key{sourceIdentity, outFrame.pixelFormat, outFrame.width, outFrame.height, target};
+            if (const auto cached = frameCache->find(key)) {
+                outFrame = *cached;
+                outFrame.arrival = utils::nowNanos(); // not the arrival of whichever read cached it
+                lastPts = outFrame.pts;
+                return {};
+            }
+        }
+
+        if (auto sought = seek(seconds); !sought) {
+            return sought;
+        }
+        // Decode from the keyframe up to the frame on screen at the target time. Frames before it are
+        // only decoded, not converted or cached.
+        while (true) {
+            if (auto decoded = decodeNext(); !decoded) {
+                return decoded;
+            }
+            const int64_t pts = avFrame->best_effort_timestamp;
+            if (pts == AV_NOPTS_VALUE || pts + frameDuration > target) {
+                if (auto converted = convertDecoded(outFrame, format); !converted) {
+                    return converted;
                 }
-                if (response < 0) {
-                    logger::error("Decoder::readFrame: Error receiving Frame from Decoder");
-                    av_packet_unref(avPacket);
-                    return false;
+                if (frameCache && outFrame.pts != AV_NOPTS_VALUE) {
+                    const FrameKey key{sourceIdentity, outFrame.pixelFormat, outFrame.width, outFrame.height,
+                                       outFrame.pts};
+                    frameCache->insert(key, frameDuration, outFrame);
                 }
+                return {};
+            }
+        }
+    }
 
-                // =========================================================
-                // CONVERSION TIME: YUV -> RGB
-                // =========================================================
-
-                // Initialize the Scaler (SwsContext) if it hasn't been created
-                // or if the Dimensions changed
-                // (Re)initialize the Scaler (SwsContext) using sws_getCachedContext
-                // so it is updated if the dimensions or pixel format change mid-stream.
-
-                swsCtx = sws_getCachedContext(
-                    swsCtx,
-                    codecCtx->width, codecCtx->height, codecCtx->pix_fmt, // Input (video)
-                    outFrame.width, outFrame.height, AV_PIX_FMT_RGBA, // Output (Frame)
-                    SWS_BILINEAR, nullptr, nullptr, nullptr
-                );
-                if (!swsCtx) {
-                    logger::error("Decoder::readFrame: Could not initialize SwsContext");
-                    av_packet_unref(avPacket);
-                    return false;
-                }
+    void Decoder::setFrameCache(FrameCache *cache) {
+        frameCache = cache;
+        if (frameCache && sourceIdentity.empty() && !sourcePath.empty()) {
+            sourceIdentity = FrameCache::fileIdentity(sourcePath);
+        }
+    }
+
+    void Decoder::setLowLatency(const bool enabled) {
+        lowLatency = enabled;
+    }
+
+    void Decoder::setKeyframesOnly(const bool enabled) {
+        keyframesOnly = enabled;
+        if (codecCtx) {
+            codecCtx->skip_frame = enabled ? AVDISCARD_NONKEY : AVDISCARD_DEFAULT;
+        }
+    }
 
-                // Prepare destination pointers for sws_scale
-                // Point to row(0) as it's a contiguous block
-                uint8_t *dest[4] = {outFrame.row(0), nullptr, nullptr, nullptr};
-                const int destLineSize[4] = {outFrame.stride, 0, 0, 0}; // 4 bytes per pixel for RGBA32
+    void Decoder::setDecodeSizeHint(const int width, const int height) {
+        hintWidth = width;
+        hintHeight = height;
+    }
 
-                // Perform the conversion
-                sws_scale(swsCtx,
-                          avFrame->data, avFrame->linesize, // Source (YUV)
-                          0, codecCtx->height, // Source height
-                          dest, destLineSize); // Destination (RGB)
+    Expected<void> Decoder::seek(const double seconds) {
+        if (!formatCtx || !codecCtx || videoStreamIndex < 0) {
+            logger::error("Decoder::seek: no video opened");
+            return Error{ErrorCode::InvalidState, "Decoder::seek: no video opened"};
+        }
 
-                // Clean up
-                av_packet_unref(avPacket);
-                return true;
-            }
+        const int64_t timestamp = toPts(seconds);
 
-            // Unreferenced packet if it wasn't video
-            av_packet_unref(avPacket);
+        // Lands on the keyframe at or before the requested time
+        if (const int result = av_seek_frame(formatCtx, videoStreamIndex, timestamp, AVSEEK_FLAG_BACKWARD); result < 0) {
+            logger::warn("Decoder::seek: could not seek to {:.3f}s", seconds);
+            return Error{ErrorCode::IOFailure, "Decoder::seek: could not seek", result};
         }
+        avcodec_flush_buffers(codecCtx);
+        draining = false;
+        return {};
+    }
+
+    void Decoder::interrupt() {
+        interrupted = true;
+        // inputSource only changes in open() and close(), which never run alongside a read
+        if (const std::shared_ptr<InputSource> source = inputSource) {
+            source->interrupt();
+        }
+    }
+
+    void Decoder::setSkipCorruptPackets(const bool enabled) {
+        skipCorrupt = enabled;
+    }
+
+    uint64_t Decoder::getCorruptPackets() const {
+        return corruptPackets;
+    }
+
+    int64_t Decoder::toPts(const double seconds) const {
+        const AVStream *stream = formatCtx->streams[videoStreamIndex];
+        auto timestamp = static_cast<int64_t>(seconds / av_q2d(stream->time_base));
+        if (stream->start_time != AV_NOPTS_VALUE) {
+            timestamp += stream->start_time;
+        }
+        return timestamp;
+    }
+
+    int64_t Decoder::arrivalOf(const int64_t pts) const {
+        if (pts != AV_NOPTS_VALUE) {
+            for (const auto &[packetPts, arrival]: arrivals) {
+                if (packetPts == pts) return arrival;
+            }
+        }
+        return utils::nowNanos();
+    }
+
+    int64_t Decoder::getLastPts() const {
+        return lastPts;
+    }
+
+    double Decoder::toSeconds(const int64_t pts) const {
+        if (!formatCtx || videoStreamIndex < 0 || pts == AV_NOPTS_VALUE) return -1;
+        const AVStream *stream = formatCtx->streams[videoStreamIndex];
+        const int64_t start = stream->start_time != AV_NOPTS_VALUE ? stream->start_time : 0;
+        return static_cast<double>(pts - start) * av_q2d(stream->time_base);
+    }
 
-        return false;
+    double Decoder::getDuration() const {
+        if (!formatCtx || formatCtx->duration == AV_NOPTS_VALUE) return -1;
+        return static_cast<double>(formatCtx->duration) / AV_TIME_BASE;
     }
 
     int Decoder::getWidth() const {
@@ -0,0 +1,45 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+
+#include "io/Fingerprinter.h"
+#include "io/KeyframeSampler.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine::io {
+    namespace {
+        // Keyframes are scaled to this size by libswscale while converting to luma; the hash then
+        // averages it down to its 32x32 block. Lowres-capable codecs decode at this size directly.
+        constexpr int kSampleSize = 128;
+    }
+
+    engine::Expected<engine::Signature> Fingerprinter::fingerprint(const std::string &filepath,
+                                                                  const FingerprintOptions &options) {
+        if (!(options.interval > 0) || options.maxFrames < 0) {
+            logger::error("Fingerprinter::fingerprint: invalid sampling options");
+            return Error{ErrorCode::InvalidArgument, "Fingerprinter::fingerprint: invalid sampling options"};
+        }
+
+        KeyframeSampler sampler(filepath, kSampleSize, kSampleSize);
+        engine::Frame luma(kSampleSize, kSampleSize, PixelFormat::GRAY8);
+        engine::Signature signature;
+
+        double nextTime = 0;
+        while (options.maxFrames == 0 || static_cast<int>(signature.hashes.size()) < options.maxFrames) {
+            const auto time = sampler.next(nextTime, luma);
+            if (!time) break;
+
+            if (const auto hash = perceptualHash(luma)) {
+                signature.hashes.push_back({std::max(*time, 0.0), *hash});
+            }
+            nextTime = std::max(nextTime, *time) + options.interval;
+        }
+
+        logger::info("Fingerprinter: {} frame hashes from {}", signature.hashes.size(), filepath);
+        return signature;
+    }
+}
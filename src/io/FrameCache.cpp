@@ -0,0 +1,427 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+
+#include "io/FrameCache.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+namespace fs = std::filesystem;
+
+namespace engine::io {
+    namespace {
+        constexpr char kMagic[8] = {'V', 'P', 'E', 'F', 'R', 'A', 'M', 'E'};
+        constexpr uint32_t kVersion = 1;
+        constexpr const char *kExtension = ".frame";
+
+        // Disk tier file layout: header, source identity, pixel rows (stride = width * bytes per pixel)
+        struct DiskHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t sourceLength;
+            int32_t width;
+            int32_t height;
+            int32_t format;
+            int32_t reserved;
+            int64_t pts;
+            int64_t duration;
+        };
+
+        bool sameStream(const FrameKey &a, const FrameKey &b) {
+            return a.source == b.source && a.format == b.format && a.width == b.width && a.height == b.height;
+        }
+
+        uint64_t hashKey(const FrameKey &key) {
+            uint64_t hash = UINT64_C(0xcbf29ce484222325); // FNV-1a
+            auto mix = [&hash](const void *data, const std::size_t size) {
+                const auto *bytes = static_cast<const uint8_t *>(data);
+                for (std::size_t i = 0; i < size; i++) {
+                    hash = (hash ^ bytes[i]) * UINT64_C(0x100000001b3);
+                }
+            };
+            const int32_t fields[3] = {static_cast<int32_t>(key.format), key.width, key.height};
+            mix(key.source.data(), key.source.size());
+            mix(fields, sizeof(fields));
+            mix(&key.pts, sizeof(key.pts));
+            return hash;
+        }
+
+        // Reads the header and source identity of a disk file, false unless the file is complete and well formed
+        bool readHeader(std::ifstream &file, const std::uintmax_t fileSize, DiskHeader &header, std::string &source) {
+            if (fileSize < sizeof(DiskHeader) || !file.read(reinterpret_cast<char *>(&header), sizeof(header))) return false;
+            if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) return false;
+
+            const int bytesPerPixel = engine::bytesPerPixel(static_cast<PixelFormat>(header.format));
+            if (bytesPerPixel == 0 || header.width <= 0 || header.height <= 0) return false;
+
+            const std::uintmax_t expected = sizeof(DiskHeader) + header.sourceLength +
+                                            static_cast<std::uintmax_t>(header.width) * bytesPerPixel * header.height;
+            if (fileSize != expected) return false;
+
+            source.resize(header.sourceLength);
+            return static_cast<bool>(file.read(source.data(), header.sourceLength));
+        }
+
+        // Temporary files get unique names, so threads spilling the same key never write the same file
+        std::atomic<uint64_t> nextTemporary{0};
+    }
+
+    FrameCache::FrameCache(FrameCacheOptions options) : options(std::move(options)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        scanDisk();
+    }
+
+    FrameCache &FrameCache::shared() {
+        static FrameCache cache;
+        return cache;
+    }
+
+    void FrameCache::configure(const FrameCacheOptions &newOptions) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (newOptions.diskDirectory != options.diskDirectory) {
+            // Forget the old directory's files (they stay on disk for a later run)
+            for (auto it = entries.begin(); it != entries.end();) {
+                Entry &entry = it->second;
+                if (entry.onDisk) {
+                    diskLru.erase(entry.diskPosition);
+                    counters.diskBytes -= entry.diskBytes;
+                    entry.onDisk = false;
+                }
+                it = entry.frame ? std::next(it) : entries.erase(it);
+            }
+            options = newOptions;
+            scanDisk();
+        } else {
+            options = newOptions;
+        }
+        std::vector<Spill> spills = evict();
+        lock.unlock();
+        store(spills);
+    }
+
+    std::string FrameCache::fileIdentity(const std::string &path) {
+        std::error_code error;
+        const fs::path canonical = fs::weakly_canonical(path, error);
+        if (error) return path;
+
+        const auto size = fs::file_size(canonical, error);
+        if (error) return canonical.string(); // not a regular file (URL, device)
+        const auto modified = fs::last_write_time(canonical, error).time_since_epoch().count();
+        return fmt::format("{}|{}|{}", canonical.string(), size, static_cast<int64_t>(modified));
+    }
+
+    void FrameCache::insert(const FrameKey &key, const int64_t duration, engine::Frame frame) {
+        if (frame.data.empty()) return;
+        const std::size_t bytes = frame.data.size();
+        auto shared = std::make_shared<const engine::Frame>(std::move(frame));
+
+        std::unique_lock<std::mutex> lock(mutex);
+        auto [it, inserted] = entries.try_emplace(key);
+        Entry &entry = it->second;
+        if (entry.frame) {
+            counters.memoryBytes -= entry.bytes;
+            memoryLru.erase(entry.memoryPosition);
+        }
+        // Content may differ from what was spilled before (e.g. a different decoder setup)
+        if (!inserted && entry.onDisk) {
+            removeFile(it->first, entry);
+        }
+
+        entry.duration = std::max<int64_t>(duration, 1);
+        entry.bytes = bytes;
+        entry.frame = std::move(shared);
+        entry.memoryPosition = memoryLru.insert(memoryLru.begin(), &it->first);
+        counters.memoryBytes += entry.bytes;
+
+        std::vector<Spill> spills = evict();
+        lock.unlock();
+        store(spills);
+    }
+
+    std::shared_ptr<const engine::Frame> FrameCache::find(const FrameKey &key) {
+        FrameKey fileKey;
+        std::string path;
+        uint64_t generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            // Last frame starting at or before key.pts, if it is still on screen at key.pts
+            auto it = entries.upper_bound(key);
+            if (it == entries.begin() || !sameStream((--it)->first, key) ||
+                key.pts >= it->first.pts + it->second.duration) {
+                counters.misses++;
+                return nullptr;
+            }
+
+            Entry &entry = it->second;
+            if (entry.frame) {
+                memoryLru.splice(memoryLru.begin(), memoryLru, entry.memoryPosition);
+                counters.hits++;
+                return entry.frame;
+            }
+            fileKey = it->first;
+            path = diskPath(fileKey);
+            generation = entry.diskGeneration;
+        }
+
+        std::shared_ptr<const engine::Frame> frame = readFile(path, fileKey);
+
+        // The entry may have changed while the file was read, so it is looked up again
+        std::unique_lock<std::mutex> lock(mutex);
+        const auto it = entries.find(fileKey);
+        if (!frame) {
+            if (it == entries.end()) {
+                counters.misses++;
+                return nullptr;
+            }
+            if (it->second.frame) { // inserted again while its old file was removed
+                counters.hits++;
+                return it->second.frame;
+            }
+            if (it->second.onDisk && it->second.diskGeneration == generation) {
+                logger::warn("FrameCache: dropping unreadable disk frame {}", path);
+                dropFromDisk(it);
+            }
+            counters.misses++;
+            return nullptr;
+        }
+        counters.hits++;
+        counters.diskHits++;
+        if (it == entries.end()) return frame; // left the disk tier meanwhile
+
+        Entry &entry = it->second;
+        if (entry.frame) return entry.frame; // read back or inserted again by another thread
+
+        // Promote back into memory; the file stays valid, so it isn't written again on eviction
+        diskLru.splice(diskLru.begin(), diskLru, entry.diskPosition);
+        entry.frame = frame;
+        entry.bytes = frame->data.size();
+        entry.memoryPosition = memoryLru.insert(memoryLru.begin(), &it->first);
+        counters.memoryBytes += entry.bytes;
+
+        std::vector<Spill> spills = evict();
+        lock.unlock();
+        store(spills);
+        return frame;
+    }
+
+    void FrameCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const FrameKey *key: diskLru) {
+            std::error_code error;
+            fs::remove(diskPath(*key), error);
+        }
+        entries.clear();
+        memoryLru.clear();
+        diskLru.clear();
+        counters.memoryBytes = 0;
+        counters.diskBytes = 0;
+    }
+
+    FrameCacheStats FrameCache::stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        FrameCacheStats result = counters;
+        result.frames = entries.size();
+        return result;
+    }
+
+    std::vector<FrameCache::Spill> FrameCache::evict() {
+        std::vector<Spill> spills;
+        while (counters.memoryBytes > options.memoryBudget && !memoryLru.empty()) {
+            const FrameKey *key = memoryLru.back();
+            const auto it = entries.find(*key);
+            Entry &entry = it->second;
+
+            memoryLru.pop_back();
+            counters.memoryBytes -= entry.bytes;
+            if (!options.diskDirectory.empty() && !entry.onDisk) {
+                // Out of the cache until store() has written it
+                spills.push_back({it->first, entry.duration, std::move(entry.frame), diskPath(it->first)});
+            }
+            entry.frame.reset();
+            if (!entry.onDisk) {
+                entries.erase(it);
+            }
+        }
+
+        while (counters.diskBytes > options.diskBudget && !diskLru.empty()) {
+            dropFromDisk(entries.find(*diskLru.back()));
+        }
+        return spills;
+    }
+
+    void FrameCache::store(std::vector<Spill> &spills) {
+        if (spills.empty()) return;
+        for (Spill &spill: spills) {
+            spill.bytes = writeFile(spill);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (Spill &spill: spills) {
+            // Skipped if the disk directory changed meanwhile: the file stays there for a later run
+            if (spill.bytes == 0 || spill.path != diskPath(spill.key)) continue;
+
+            auto [it, inserted] = entries.try_emplace(std::move(spill.key));
+            Entry &entry = it->second;
+            if (entry.frame) {
+                // Inserted again meanwhile, possibly with different content (see insert())
+                std::error_code error;
+                if (entry.onDisk) {
+                    removeFile(it->first, entry);
+                } else {
+                    fs::remove(spill.path, error);
+                }
+                continue;
+            }
+            if (entry.onDisk) continue; // spilled by another thread as well, to the same file
+
+            entry.duration = spill.duration;
+            entry.onDisk = true;
+            entry.diskBytes = spill.bytes;
+            entry.diskGeneration = ++diskGenerations;
+            entry.diskPosition = diskLru.insert(diskLru.begin(), &it->first);
+            counters.diskBytes += entry.diskBytes;
+        }
+
+        while (counters.diskBytes > options.diskBudget && !diskLru.empty()) {
+            dropFromDisk(entries.find(*diskLru.back()));
+        }
+    }
+
+    void FrameCache::removeFile(const FrameKey &key, Entry &entry) {
+        std::error_code error;
+        fs::remove(diskPath(key), error);
+        diskLru.erase(entry.diskPosition);
+        counters.diskBytes -= entry.diskBytes;
+        entry.onDisk = false;
+    }
+
+    void FrameCache::dropFromDisk(const EntryMap::iterator it) {
+        removeFile(it->first, it->second);
+        if (!it->second.frame) {
+            entries.erase(it);
+        }
+    }
+
+    std::size_t FrameCache::writeFile(const Spill &spill) {
+        const engine::Frame &frame = *spill.frame;
+
+        DiskHeader header{};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.sourceLength = static_cast<uint32_t>(spill.key.source.size());
+        header.width = frame.width;
+        header.height = frame.height;
+        header.format = static_cast<int32_t>(frame.pixelFormat);
+        header.pts = spill.key.pts;
+        header.duration = spill.duration;
+
+        // Written under a temporary name so readers never see a partial file
+        const std::string temporary = fmt::format("{}.{}.tmp", spill.path,
+                                                  nextTemporary.fetch_add(1, std::memory_order_relaxed));
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(spill.key.source.data(), static_cast<std::streamsize>(spill.key.source.size()));
+            const int rowBytes = frame.width * frame.bytesPerPixel();
+            for (int y = 0; y < frame.height; y++) {
+                file.write(reinterpret_cast<const char *>(frame.row(y)), rowBytes);
+            }
+            if (!file) {
+                logger::warn("FrameCache: could not write {}", temporary);
+                std::error_code error;
+                fs::remove(temporary, error);
+                return 0;
+            }
+        }
+
+        std::error_code error;
+        fs::rename(temporary, spill.path, error);
+        if (error) {
+            logger::warn("FrameCache: could not write {}: {}", spill.path, error.message());
+            fs::remove(temporary, error);
+            return 0;
+        }
+        return sizeof(header) + spill.key.source.size() +
+               static_cast<std::size_t>(frame.width) * frame.bytesPerPixel() * frame.height;
+    }
+
+    std::shared_ptr<const engine::Frame> FrameCache::readFile(const std::string &path, const FrameKey &key) {
+        std::error_code error;
+        const std::uintmax_t fileSize = fs::file_size(path, error);
+        std::ifstream file(path, std::ios::binary);
+        if (error || !file) return nullptr;
+
+        DiskHeader header{};
+        std::string source;
+        if (!readHeader(file, fileSize, header, source) || header.pts != key.pts || header.width != key.width ||
+            header.height != key.height || static_cast<PixelFormat>(header.format) != key.format ||
+            source != key.source) {
+            return nullptr;
+        }
+
+        auto frame = std::make_shared<engine::Frame>(key.width, key.height, key.format);
+        if (!file.read(reinterpret_cast<char *>(frame->data.data()), static_cast<std::streamsize>(frame->data.size()))) {
+            return nullptr;
+        }
+        frame->pts = key.pts;
+        return frame;
+    }
+
+    void FrameCache::scanDisk() {
+        if (options.diskDirectory.empty()) return;
+
+        std::error_code error;
+        fs::create_directories(options.diskDirectory, error);
+        if (error) {
+            logger::warn("FrameCache: could not create {}: {}", options.diskDirectory, error.message());
+            return;
+        }
+
+        // Oldest first, so the most recently written files end up at the front of the LRU list
+        std::vector<std::pair<fs::file_time_type, fs::path> > files;
+        for (const auto &item: fs::directory_iterator(options.diskDirectory, error)) {
+            if (item.is_regular_file() && item.path().extension() == kExtension) {
+                files.emplace_back(item.last_write_time(error), item.path());
+            }
+        }
+        std::sort(files.begin(), files.end());
+
+        for (const auto &[modified, path]: files) {
+            const std::uintmax_t fileSize = fs::file_size(path, error);
+            std::ifstream file(path, std::ios::binary);
+            DiskHeader header{};
+            FrameKey key;
+            if (error || !file || !readHeader(file, fileSize, header, key.source)) continue;
+
+            key.format = static_cast<PixelFormat>(header.format);
+            key.width = header.width;
+            key.height = header.height;
+            key.pts = header.pts;
+            if (diskPath(key) != path.string()) continue; // not written by this cache
+
+            auto [it, inserted] = entries.try_emplace(std::move(key));
+            Entry &entry = it->second;
+            if (entry.onDisk) continue;
+            if (inserted) entry.duration = header.duration;
+            entry.onDisk = true;
+            entry.diskBytes = fileSize;
+            entry.diskGeneration = ++diskGenerations;
+            entry.diskPosition = diskLru.insert(diskLru.begin(), &it->first);
+            counters.diskBytes += entry.diskBytes;
+        }
+    }
+
+    std::string FrameCache::diskPath(const FrameKey &key) const {
+        return (fs::path(options.diskDirectory) / fmt::format("{:016x}{}", hashKey(key), kExtension)).string();
+    }
+}
@@ -0,0 +1,266 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <fmt/format.h>
+
+#include "io/InputSource.h"
+#include "io/FrameCache.h"
+#include "io/MappedFile.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine::io {
+    namespace {
+        std::atomic<uint64_t> nextSerial{0};
+
+        // How long a pipe read waits for data before checking for interrupt()
+        constexpr int kPollMillis = 50;
+
+        // Instance numbers restart with every process while the disk tier of the frame cache outlives it,
+        // so identities also carry a random per-process tag
+        uint64_t processTag() {
+            static const uint64_t tag = [] {
+                std::random_device device;
+                return (static_cast<uint64_t>(device()) << 32) | device();
+            }();
+            return tag;
+        }
+
+        // Seek arithmetic shared by the sources that know their size
+        int64_t resolve(const int64_t offset, const int whence, const int64_t position, const int64_t size) {
+            switch (whence) {
+                case SEEK_SET: return offset;
+                case SEEK_CUR: return position + offset;
+                case SEEK_END: return size < 0 ? -1 : size + offset;
+                default: return -1;
+            }
+        }
+
+        class MemorySource final : public InputSource {
+        public:
+            MemorySource(const uint8_t *data, const std::size_t length, std::string label)
+                : base(data), length(length), label(std::move(label)) {
+            }
+
+            MemorySource(std::vector<uint8_t> buffer, std::string label)
+                : owned(std::move(buffer)), label(std::move(label)) {
+                base = owned.data();
+                length = owned.size();
+            }
+
+            MemorySource(MappedFile file, std::string label)
+                : mapped(std::move(file)), label(std::move(label)), fileIdentity(FrameCache::fileIdentity(this->label)) {
+                base = mapped.data();
+                length = mapped.size();
+            }
+
+            int read(uint8_t *buffer, const int size) override {
+                const std::size_t count = std::min(static_cast<std::size_t>(size), length - position);
+                std::memcpy(buffer, base + position, count);
+                position += count;
+                return static_cast<int>(count);
+            }
+
+            [[nodiscard]] bool seekable() const override { return true; }
+
+            int64_t seek(const int64_t offset, const int whence) override {
+                const int64_t target = resolve(offset, whence, static_cast<int64_t>(position), size());
+                if (target < 0 || target > size()) return -1;
+                position = static_cast<std::size_t>(target);
+                return target;
+            }
+
+            [[nodiscard]] int64_t size() const override { return static_cast<int64_t>(length); }
+
+            [[nodiscard]] std::string name() const override { return label; }
+
+            [[nodiscard]] std::string identity() const override {
+                return fileIdentity.empty() ? InputSource::identity() : fileIdentity;
+            }
+
+        private:
+            const uint8_t *base = nullptr;
+            std::size_t length = 0;
+            std::size_t position = 0;
+
+            std::vector<uint8_t> owned;
+            MappedFile mapped;
+            std::string label;
+            std::string fileIdentity; // mapped files only
+        };
+
+        class CallbackSource final : public InputSource {
+        public:
+            CallbackSource(ReadCallback reader, SeekCallback seeker, std::string label)
+                : reader(std::move(reader)), seeker(std::move(seeker)), label(std::move(label)) {
+            }
+
+            int read(uint8_t *buffer, const int size) override { return reader(buffer, size); }
+
+            [[nodiscard]] bool seekable() const override { return static_cast<bool>(seeker); }
+
+            int64_t seek(const int64_t offset, const int whence) override {
+                return seeker ? seeker(offset, whence) : -1;
+            }
+
+            [[nodiscard]] std::string name() const override { return label; }
+
+        private:
+            ReadCallback reader;
+            SeekCallback seeker;
+            std::string label;
+        };
+
+        class PipeSource final : public InputSource {
+        public:
+            PipeSource(std::FILE *stream, std::string label) : stream(stream), label(std::move(label)) {
+            }
+
+            // Straight from the file descriptor: fread would wait until the whole buffer is filled, holding
+            // back packets that already arrived on a live pipe
+            int read(uint8_t *buffer, const int size) override {
+                const int descriptor = fileno(stream);
+                while (!interrupted.load(std::memory_order_relaxed)) {
+#ifdef _WIN32
+                    const int count = _read(descriptor, buffer, static_cast<unsigned int>(size));
+#else
+                    // Waits in short slices so an interrupt() is noticed while the pipe is quiet
+                    pollfd ready{descriptor, POLLIN, 0};
+                    const int polled = ::poll(&ready, 1, kPollMillis);
+                    if (polled == 0) continue;
+                    if (polled < 0) {
+                        if (errno == EINTR) continue;
+                        return -1;
+                    }
+                    const auto count = ::read(descriptor, buffer, static_cast<std::size_t>(size));
+#endif
+                    if (count >= 0) return static_cast<int>(count);
+                    if (errno != EINTR) return -1;
+                }
+                return -1;
+            }
+
+            void interrupt() override { interrupted = true; }
+
+            [[nodiscard]] std::string name() const override { return label; }
+
+        private:
+            std::FILE *stream;
+            std::string label;
+            std::atomic<bool> interrupted = false;
+        };
+    }
+
+    InputSource::InputSource() : serial(nextSerial.fetch_add(1, std::memory_order_relaxed)) {
+    }
+
+    int64_t InputSource::seek(int64_t, int) {
+        return -1;
+    }
+
+    std::string InputSource::identity() const {
+        return fmt::format("{}#{:016x}.{}", name(), processTag(), serial);
+    }
+
+    std::shared_ptr<InputSource> InputSource::fromMemory(const uint8_t *data, const std::size_t size,
+                                                         std::string name) {
+        return std::make_shared<MemorySource>(data, size, std::move(name));
+    }
+
+    std::shared_ptr<InputSource> InputSource::fromBuffer(std::vector<uint8_t> data, std::string name) {
+        return std::make_shared<MemorySource>(std::move(data), std::move(name));
+    }
+
+    std::shared_ptr<InputSource> InputSource::fromCallbacks(ReadCallback read, SeekCallback seek, std::string name) {
+        return std::make_shared<CallbackSource>(std::move(read), std::move(seek), std::move(name));
+    }
+
+    std::shared_ptr<InputSource> InputSource::fromPipe(std::FILE *stream, std::string name) {
+        return std::make_shared<PipeSource>(stream, std::move(name));
+    }
+
+    std::shared_ptr<InputSource> InputSource::mapFile(const std::string &path) {
+        MappedFile file;
+        if (!file.open(path)) {
+            logger::error("InputSource::mapFile: could not map {}", path);
+            return nullptr;
+        }
+        return std::make_shared<MemorySource>(std::move(file), path);
+    }
+
+    StreamingSource::StreamingSource(std::string name) : label(std::move(name)) {
+    }
+
+    void StreamingSource::append(const uint8_t *chunk, const std::size_t size) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            data.insert(data.end(), chunk, chunk + size);
+        }
+        arrived.notify_all();
+    }
+
+    void StreamingSource::finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished = true;
+        }
+        arrived.notify_all();
+    }
+
+    void StreamingSource::fail() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+        }
+        arrived.notify_all();
+    }
+
+    int StreamingSource::read(uint8_t *buffer, const int size) {
+        std::unique_lock<std::mutex> lock(mutex);
+        arrived.wait(lock, [&] { return failed || finished || position < data.size(); });
+        if (failed) return -1;
+
+        // Whatever is there already, so demuxing keeps pace with the upload
+        const std::size_t count = std::min(static_cast<std::size_t>(size), data.size() - position);
+        std::memcpy(buffer, data.data() + position, count);
+        position += count;
+        return static_cast<int>(count);
+    }
+
+    int64_t StreamingSource::seek(const int64_t offset, const int whence) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (whence == SEEK_END) {
+            arrived.wait(lock, [&] { return failed || finished; });
+        }
+        if (failed) return -1;
+
+        const int64_t target = resolve(offset, whence, static_cast<int64_t>(position),
+                                       static_cast<int64_t>(data.size()));
+        if (target < 0) return -1;
+
+        arrived.wait(lock, [&] { return failed || finished || static_cast<int64_t>(data.size()) >= target; });
+        if (failed || target > static_cast<int64_t>(data.size())) return -1;
+        position = static_cast<std::size_t>(target);
+        return target;
+    }
+
+    int64_t StreamingSource::size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return finished ? static_cast<int64_t>(data.size()) : -1;
+    }
+}
@@ -0,0 +1,45 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include "io/KeyframeSampler.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine::io {
+    KeyframeSampler::KeyframeSampler(const std::string &filepath, const int hintWidth, const int hintHeight)
+        : path(filepath) {
+        source.setKeyframesOnly(true);
+        source.setDecodeSizeHint(hintWidth, hintHeight);
+        source.open(filepath);
+
+        length = source.getDuration();
+        seekable = length > 0;
+    }
+
+    engine::Expected<double> KeyframeSampler::next(const double time, const engine::FrameView dest) {
+        if (seekable && time > 0) {
+            if (time >= length) {
+                return Error{ErrorCode::EndOfStream, "KeyframeSampler: past the end of the video"};
+            }
+            // Without seeking, keep reading forward to the requested time instead
+            seekable = static_cast<bool>(source.seek(time));
+        }
+
+        while (true) {
+            if (const auto read = source.readFrameInto(dest); !read) {
+                if (!read.is(ErrorCode::EndOfStream)) {
+                    logger::warn("KeyframeSampler: stopped reading {}: {}", path, read.error().message);
+                }
+                return read.error();
+            }
+            const double frameTime = source.toSeconds(source.getLastPts());
+            // Sparse keyframes: a seek can land on the keyframe that was already sampled
+            if (frameTime < 0 || (frameTime > lastTime && (seekable || frameTime >= time))) {
+                lastTime = frameTime;
+                return frameTime;
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifndef ENGINE_KEYFRAMESAMPLER_H
+#define ENGINE_KEYFRAMESAMPLER_H
+
+#pragma once
+
+#include <string>
+
+#include "engine/Error.h"
+#include "engine/Frame.h"
+#include "io/Decoder.h"
+
+namespace engine::io {
+    // Samples a video at increasing times from its keyframes only: each sample is the first keyframe
+    // at or after the requested time. Seeks ahead while the input allows it and reads forward otherwise.
+    // Shared by Thumbnailer and Fingerprinter.
+    class KeyframeSampler {
+    public:
+        // Opens filepath for keyframe-only decoding. Codecs with lowres support decode at reduced
+        // size when that still covers hintWidth x hintHeight.
+        KeyframeSampler(const std::string &filepath, int hintWidth, int hintHeight);
+
+        // Decodes the sample for time (seconds, non-decreasing between calls) scaled into dest and
+        // returns its time, -1 if unknown. EndOfStream once the video ends first. dest may be
+        // overwritten even when no sample is returned.
+        engine::Expected<double> next(double time, engine::FrameView dest);
+
+        // False once seeking failed or for inputs without a known duration; samples then come from
+        // reading forward
+        [[nodiscard]] bool canSeek() const { return seekable; }
+
+        // Container duration in seconds (-1 if unknown)
+        [[nodiscard]] double duration() const { return length; }
+
+        [[nodiscard]] Decoder &decoder() { return source; }
+
+    private:
+        Decoder source;
+        std::string path;
+        double length = -1;
+        bool seekable = false;
+        double lastTime = -1;
+    };
+}
+
+#endif //ENGINE_KEYFRAMESAMPLER_H
@@ -0,0 +1,105 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+#include "io/MappedFile.h"
+
+namespace engine::io {
+    MappedFile::~MappedFile() {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+        : mapping(std::exchange(other.mapping, nullptr)), length(std::exchange(other.length, 0)),
+          opened(std::exchange(other.opened, false)) {
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            close();
+            mapping = std::exchange(other.mapping, nullptr);
+            length = std::exchange(other.length, 0);
+            opened = std::exchange(other.opened, false);
+        }
+        return *this;
+    }
+
+    bool MappedFile::open(const std::string &path) {
+        close();
+
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) {
+            CloseHandle(file);
+            return false;
+        }
+        if (size.QuadPart > 0) {
+            HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (view) {
+                mapping = static_cast<const uint8_t *>(MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0));
+                CloseHandle(view);
+            }
+            if (!mapping) {
+                CloseHandle(file);
+                return false;
+            }
+        }
+        CloseHandle(file);
+        length = static_cast<std::size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+
+        struct stat info{};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        if (info.st_size > 0) {
+            void *address = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                return false;
+            }
+            mapping = static_cast<const uint8_t *>(address);
+        }
+        // The mapping keeps the file referenced
+        ::close(fd);
+        length = static_cast<std::size_t>(info.st_size);
+#endif
+
+        opened = true;
+        return true;
+    }
+
+    void MappedFile::close() {
+        if (mapping) {
+#ifdef _WIN32
+            UnmapViewOfFile(mapping);
+#else
+            munmap(const_cast<uint8_t *>(mapping), length);
+#endif
+        }
+        mapping = nullptr;
+        length = 0;
+        opened = false;
+    }
+}
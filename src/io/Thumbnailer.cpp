@@ -0,0 +1,76 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include "io/Thumbnailer.h"
+#include "io/KeyframeSampler.h"
+#include "utils/Logger.h"
+
+namespace logger = engine::utils::Logger;
+
+namespace engine::io {
+    engine::Expected<SpriteSheet> Thumbnailer::createSpriteSheet(const std::string &filepath,
+                                                                const SpriteSheetOptions &options) {
+        if (options.columns <= 0 || options.rows <= 0 || options.tileWidth <= 0 || options.tileHeight < 0) {
+            logger::error("Thumbnailer::createSpriteSheet: invalid sprite sheet layout");
+            return Error{ErrorCode::InvalidArgument, "Thumbnailer::createSpriteSheet: invalid sprite sheet layout"};
+        }
+        if (options.pixelFormat == PixelFormat::UNKNOWN) {
+            logger::error("Thumbnailer::createSpriteSheet: pixel format unsupported");
+            return Error{ErrorCode::UnsupportedFormat, "Thumbnailer::createSpriteSheet: pixel format unsupported"};
+        }
+
+        KeyframeSampler sampler(filepath, options.tileWidth, std::max(options.tileHeight, 1));
+
+        SpriteSheet result;
+        result.columns = options.columns;
+        result.tileWidth = options.tileWidth;
+        result.tileHeight = options.tileHeight;
+        if (result.tileHeight == 0) {
+            const int width = std::max(sampler.decoder().getWidth(), 1);
+            result.tileHeight = std::max(2, (options.tileWidth * sampler.decoder().getHeight() / width) & ~1);
+        }
+
+        const int capacity = options.columns * options.rows;
+        result.sheet = engine::Frame(options.columns * result.tileWidth, options.rows * result.tileHeight,
+                                     options.pixelFormat);
+
+        double interval = options.interval;
+        if (interval <= 0 && sampler.canSeek()) {
+            interval = sampler.duration() / capacity;
+        }
+
+        int count = 0;
+        double nextTime = 0;
+
+        while (count < capacity) {
+            const int x = (count % options.columns) * result.tileWidth;
+            const int y = (count / options.columns) * result.tileHeight;
+            const engine::FrameView tile = result.sheet.view(x, y, result.tileWidth, result.tileHeight);
+
+            const auto time = sampler.next(nextTime, tile);
+            if (!time) {
+                // The sampler may have decoded a rejected frame into the tile; keep the slot blank
+                for (int row = 0; row < tile.height; row++) {
+                    std::memset(tile.row(row), 0, tile.rowBytes());
+                }
+                break;
+            }
+
+            result.timestamps.push_back(*time);
+            count++;
+            nextTime = sampler.canSeek() ? count * interval : *time + interval;
+        }
+
+        // Drop the rows that were never filled
+        const int usedRows = (count + options.columns - 1) / options.columns;
+        result.sheet.height = usedRows * result.tileHeight;
+        result.sheet.data.resize(static_cast<size_t>(result.sheet.stride) * result.sheet.height);
+
+        logger::info("Thumbnailer: {} thumbnails from {}", count, filepath);
+        return result;
+    }
+}
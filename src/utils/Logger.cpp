@@ -0,0 +1,251 @@
+//
+// Created by HuyN on 19/10/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <fmt/color.h>
+#include <fmt/format.h>
+
+#include "utils/Logger.h"
+
+namespace engine::utils::Logger {
+    namespace {
+        constexpr std::size_t kRingSize = 512; // records per thread, power of two
+        constexpr auto kFlushInterval = std::chrono::milliseconds(10);
+
+        constexpr std::size_t kRateSites = 256; // power of two
+        constexpr std::size_t kRateProbes = 4;
+        constexpr uint32_t kRateBurst = 5; // messages per call site per second
+
+        // Single producer (the owning thread), single consumer (whoever holds Backend::mutex)
+        struct Ring {
+            alignas(64) std::atomic<uint64_t> head{0};
+            alignas(64) std::atomic<uint64_t> tail{0};
+            std::atomic<uint64_t> dropped{0};
+            std::atomic<bool> retired{false};
+            std::array<detail::Record, kRingSize> records;
+        };
+
+        struct RingHandle {
+            std::shared_ptr<Ring> ring;
+
+            ~RingHandle() {
+                if (ring) ring->retired.store(true, std::memory_order_release);
+            }
+        };
+
+        struct RateSite {
+            std::atomic<const char *> key{nullptr};
+            std::atomic<int64_t> window{0};
+            std::atomic<uint32_t> count{0};
+            std::atomic<uint32_t> suppressed{0};
+        };
+
+        std::array<RateSite, kRateSites> rateSites;
+
+        void appendTag(fmt::memory_buffer &out, const Level level) {
+            fmt::color color = fmt::color::cyan;
+            const char *name = "INFO";
+            switch (level) {
+                case Level::Success: color = fmt::color::green; name = "SUCCESS"; break;
+                case Level::Warn: color = fmt::color::yellow; name = "WARN"; break;
+                case Level::Error: color = fmt::color::red; name = "ERROR"; break;
+                default: break;
+            }
+            fmt::format_to(fmt::appender(out), fg(color) | fmt::emphasis::bold, "[{:^9}] ", name);
+        }
+
+        class Backend {
+        public:
+            // Intentionally leaked: worker threads may still log while static destructors run
+            static Backend &instance() {
+                static Backend *backend = new Backend();
+                return *backend;
+            }
+
+            std::shared_ptr<Ring> attach() {
+                auto ring = std::make_shared<Ring>();
+                std::lock_guard<std::mutex> lock(mutex);
+                rings.push_back(ring);
+                return ring;
+            }
+
+            void drain() {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                batch.clear();
+                heads.clear();
+                uint64_t dropped = 0;
+                for (const auto &ring: rings) {
+                    const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+                    const uint64_t head = ring->head.load(std::memory_order_acquire);
+                    for (uint64_t i = tail; i < head; i++) {
+                        batch.push_back(&ring->records[i & (kRingSize - 1)]);
+                    }
+                    heads.push_back(head);
+                    dropped += ring->dropped.exchange(0, std::memory_order_relaxed);
+                }
+
+                if (!batch.empty() || dropped) {
+                    // Rings are drained together so cross-thread order follows the global sequence
+                    std::sort(batch.begin(), batch.end(), [](const detail::Record *a, const detail::Record *b) {
+                        return a->seq < b->seq;
+                    });
+
+                    out.clear();
+                    for (const detail::Record *record: batch) {
+                        appendTag(out, record->level);
+                        out.append(record->text, record->text + record->length);
+                        if (record->truncated) {
+                            fmt::format_to(fmt::appender(out), "...");
+                        }
+                        if (record->suppressed) {
+                            fmt::format_to(fmt::appender(out), " (suppressed {} similar messages)", record->suppressed);
+                        }
+                        out.push_back('\n');
+                    }
+                    if (dropped) {
+                        appendTag(out, Level::Warn);
+                        fmt::format_to(fmt::appender(out), "Logger: dropped {} messages (ring full)\n", dropped);
+                    }
+
+                    std::fwrite(out.data(), 1, out.size(), stdout);
+                    std::fflush(stdout);
+                }
+
+                // Release the slots only after the text has been copied out
+                std::size_t index = 0;
+                for (auto it = rings.begin(); it != rings.end(); index++) {
+                    Ring &ring = **it;
+                    ring.tail.store(heads[index], std::memory_order_release);
+
+                    if (ring.retired.load(std::memory_order_acquire) &&
+                        ring.head.load(std::memory_order_acquire) == heads[index]) {
+                        it = rings.erase(it);
+                    } else {
+                        ++it;
+                    }
+                }
+            }
+
+            void shutdown() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (stopping) return;
+                    stopping = true;
+                }
+                wake.notify_all();
+                if (worker.joinable()) worker.join();
+                stopped.store(true, std::memory_order_release);
+                drain();
+            }
+
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<bool> stopped{false};
+
+        private:
+            Backend() {
+                worker = std::thread([this] { run(); });
+                std::atexit([] { instance().shutdown(); });
+            }
+
+            void run() {
+                std::unique_lock<std::mutex> lock(mutex);
+                while (!stopping) {
+                    wake.wait_for(lock, kFlushInterval);
+                    lock.unlock();
+                    drain();
+                    lock.lock();
+                }
+            }
+
+            std::mutex mutex; // guards the ring list and the consumer side; only ERROR takes it when logging
+            std::condition_variable wake;
+            std::vector<std::shared_ptr<Ring> > rings;
+            std::vector<const detail::Record *> batch;
+            std::vector<uint64_t> heads;
+            fmt::memory_buffer out;
+            std::thread worker;
+            bool stopping = false;
+        };
+
+        RingHandle &localRing() {
+            thread_local RingHandle handle;
+            if (!handle.ring) {
+                handle.ring = Backend::instance().attach();
+            }
+            return handle;
+        }
+    }
+
+    namespace detail {
+        Record *acquire() {
+            Ring &ring = *localRing().ring;
+            const uint64_t head = ring.head.load(std::memory_order_relaxed);
+            const uint64_t tail = ring.tail.load(std::memory_order_acquire);
+            if (head - tail >= kRingSize) {
+                ring.dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            return &ring.records[head & (kRingSize - 1)];
+        }
+
+        void publish(Record *record) {
+            Backend &backend = Backend::instance();
+            Ring &ring = *localRing().ring;
+            record->seq = backend.sequence.fetch_add(1, std::memory_order_relaxed);
+            ring.head.store(ring.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+            // Past shutdown there is no flusher left, write synchronously
+            if (backend.stopped.load(std::memory_order_acquire)) {
+                backend.drain();
+            }
+        }
+
+        bool admit(const char *site, uint32_t &suppressed) {
+            const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+            const auto hash = static_cast<std::size_t>(
+                (reinterpret_cast<uintptr_t>(site) >> 3) * UINT64_C(0x9E3779B97F4A7C15) >> 32);
+
+            for (std::size_t probe = 0; probe < kRateProbes; probe++) {
+                RateSite &entry = rateSites[(hash + probe) & (kRateSites - 1)];
+
+                const char *key = entry.key.load(std::memory_order_acquire);
+                if (key == nullptr && entry.key.compare_exchange_strong(key, site)) {
+                    key = site;
+                }
+                if (key != site) continue;
+
+                int64_t window = entry.window.load(std::memory_order_relaxed);
+                if (window != now && entry.window.compare_exchange_strong(window, now)) {
+                    entry.count.store(0, std::memory_order_relaxed);
+                    suppressed = entry.suppressed.exchange(0, std::memory_order_relaxed);
+                }
+
+                if (entry.count.fetch_add(1, std::memory_order_relaxed) < kRateBurst) {
+                    return true;
+                }
+                entry.suppressed.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            // Table crowded around this hash: never limit rather than guess
+            return true;
+        }
+    }
+
+    void flush() {
+        Backend::instance().drain();
+    }
+}
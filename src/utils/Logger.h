@@ -7,45 +7,122 @@
 
 #pragma once
 
-#include <mutex>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <fmt/core.h>
-#include <fmt/color.h>
 
+#include "engine/LogLevel.h"
+
+// Compile-time threshold. Calls below it compile to nothing (arguments are never formatted).
+// 0 = INFO, 1 = SUCCESS, 2 = WARN, 3 = ERROR, 4 = OFF
+#ifndef ENGINE_LOG_LEVEL
+#define ENGINE_LOG_LEVEL 0
+#endif
+
+// Messages are formatted on the calling thread into a per-thread lock-free ring and written out
+// by a background flusher, so logging never takes a lock or touches stdout on the caller's thread.
+// WARN is rate limited per call site; the count of suppressed repeats is reported with the next
+// message that gets through. ERROR is the exception to both: never limited, and written out (with
+// everything logged before it) before the call returns, so it is not lost to an abort right after.
 namespace engine::utils::Logger {
+    using Level = engine::LogLevel;
+
+    namespace detail {
+        inline constexpr std::size_t kMessageCapacity = 232;
+
+        struct Record {
+            uint64_t seq = 0;
+            uint32_t suppressed = 0; // repeats of this call site dropped by the rate limiter
+            uint16_t length = 0;
+            Level level = Level::Info;
+            bool truncated = false;
+            char text[kMessageCapacity];
+        };
+
+        // Next free record of the calling thread's ring, nullptr if the ring is full (message dropped)
+        Record *acquire();
 
-    inline std::mutex& getMutex() {
-        static std::mutex m;
-        return m;
+        // Hands a filled record over to the flusher
+        void publish(Record *record);
+
+        // Rate limiter keyed by the format string address (one entry per call site)
+        bool admit(const char *site, uint32_t &suppressed);
+
+        inline std::atomic<Level> &threshold() {
+            static std::atomic<Level> level{Level::Info};
+            return level;
+        }
     }
 
-    template<typename... Args>
-    inline void log(fmt::color color, std::string_view level, fmt::format_string<Args...> format, Args&&... args) {
-        std::lock_guard<std::mutex> lock(getMutex());
-        fmt::print(fg(color) | fmt::emphasis::bold, "[{:^9}] ", level);
-        fmt::print(format, std::forward<Args>(args)...);
-        fmt::print("\n");
+    // Runtime threshold on top of ENGINE_LOG_LEVEL (e.g. from engine::Config)
+    inline void setLevel(const Level level) {
+        detail::threshold().store(level, std::memory_order_relaxed);
+    }
+
+    inline Level level() {
+        return detail::threshold().load(std::memory_order_relaxed);
+    }
+
+    // Writes every pending message before returning
+    void flush();
+
+    template<Level L, typename... Args>
+    inline void log(fmt::format_string<Args...> format, Args &&... args) {
+        if constexpr (static_cast<int>(L) < ENGINE_LOG_LEVEL) {
+            return;
+        } else {
+            if (L < level()) return;
+
+            uint32_t suppressed = 0;
+            if constexpr (L == Level::Warn) {
+                if (!detail::admit(fmt::string_view(format).data(), suppressed)) return;
+            }
+
+            detail::Record *record = detail::acquire();
+            if constexpr (L >= Level::Error) {
+                if (!record) {
+                    flush();
+                    record = detail::acquire();
+                }
+            }
+            if (!record) return;
+
+            const auto result = fmt::format_to_n(record->text, detail::kMessageCapacity, format,
+                                                 std::forward<Args>(args)...);
+            record->length = static_cast<uint16_t>(std::min(result.size, detail::kMessageCapacity));
+            record->truncated = result.size > detail::kMessageCapacity;
+            record->level = L;
+            record->suppressed = suppressed;
+            detail::publish(record);
+
+            if constexpr (L >= Level::Error) {
+                flush();
+            }
+        }
     }
 
     template<typename... Args>
     inline void info(fmt::format_string<Args...> fmt, Args&&... args) {
-        log(fmt::color::cyan, "INFO", fmt, std::forward<Args>(args)...);
+        log<Level::Info>(fmt, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     inline void success(fmt::format_string<Args...> fmt, Args&&... args) {
-        log(fmt::color::green, "SUCCESS", fmt, std::forward<Args>(args)...);
+        log<Level::Success>(fmt, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     inline void warn(fmt::format_string<Args...> fmt, Args&&... args) {
-        log(fmt::color::yellow, "WARN", fmt, std::forward<Args>(args)...);
+        log<Level::Warn>(fmt, std::forward<Args>(args)...);
     }
 
     template<typename... Args>
     inline void error(fmt::format_string<Args...> fmt, Args&&... args) {
-        log(fmt::color::red, "ERROR", fmt, std::forward<Args>(args)...);
+        log<Level::Error>(fmt, std::forward<Args>(args)...);
     }
 }
 
-#endif //ENGINE_LOGGER_H
\ No newline at end of file
+#endif //ENGINE_LOGGER_H
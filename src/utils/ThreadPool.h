@@ -5,4 +5,189 @@
 #ifndef ENGINE_THREADPOOL_H
 #define ENGINE_THREADPOOL_H
 
-#endif //ENGINE_THREADPOOL_H
\ No newline at end of file
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine::utils {
+    class ThreadPool {
+    public:
+        // threads = 0 picks one worker per hardware thread minus the caller's
+        explicit ThreadPool(const std::size_t threads = 0) {
+            start(threads);
+        }
+
+        ~ThreadPool() {
+            stop();
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        static ThreadPool &shared() {
+            static ThreadPool pool;
+            return pool;
+        }
+
+        // Replaces the workers (same meaning of 0 as the constructor). Queued tasks finish first.
+        // Refused (false, nothing changes) while a parallelFor runs on any thread, as its helpers are
+        // queued for or running on the current workers; parallelFor calls that start during a resize
+        // run on their calling thread alone.
+        bool resize(const std::size_t threads) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (active > 0 || resizing) return false;
+                resizing = true;
+            }
+            stop();
+            start(threads);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            resizing = false;
+            return true;
+        }
+
+        // Workers plus the calling thread
+        [[nodiscard]] std::size_t concurrency() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return workers.size() + 1;
+        }
+
+        void submit(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                tasks.push_back(std::move(task));
+            }
+            wake.notify_one();
+        }
+
+        // Calls fn(begin, end) on chunks of [0, count), each at least grain long, and returns once all
+        // chunks are done. The calling thread works too, so nested calls from a worker cannot deadlock.
+        void parallelFor(const int count, const int grain, const std::function<void(int, int)> &fn) {
+            if (count <= 0) return;
+
+            const int chunkSize = std::max(grain, 1);
+            const int chunks = (count + chunkSize - 1) / chunkSize;
+
+            // Registered as active, so resize() leaves the workers alone until this call returns
+            std::size_t available = 0;
+            if (chunks > 1) {
+                std::lock_guard<std::mutex> lock(mutex);
+                available = resizing ? 0 : workers.size();
+                if (available) active++;
+            }
+            if (available == 0) {
+                fn(0, count);
+                return;
+            }
+            struct Release {
+                ThreadPool &pool;
+
+                ~Release() {
+                    std::lock_guard<std::mutex> lock(pool.mutex);
+                    pool.active--;
+                }
+            } release{*this};
+
+            struct State {
+                std::atomic<int> next{0};
+                std::atomic<int> completed{0};
+                std::mutex mutex;
+                std::condition_variable done;
+                std::exception_ptr error;
+            };
+            auto state = std::make_shared<State>();
+
+            // Helpers that start after every chunk is claimed return without touching fn
+            auto work = [state, chunks, chunkSize, count, &fn] {
+                int finished = 0;
+                for (int chunk = state->next.fetch_add(1); chunk < chunks; chunk = state->next.fetch_add(1)) {
+                    try {
+                        fn(chunk * chunkSize, std::min(count, (chunk + 1) * chunkSize));
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    finished++;
+                }
+                if (finished && state->completed.fetch_add(finished) + finished == chunks) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->done.notify_all();
+                }
+            };
+
+            const std::size_t helpers = std::min(available, static_cast<std::size_t>(chunks - 1));
+            for (std::size_t i = 0; i < helpers; i++) {
+                submit(work);
+            }
+            work();
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->done.wait(lock, [&] { return state->completed.load() == chunks; });
+            if (state->error) {
+                std::rethrow_exception(state->error);
+            }
+        }
+
+    private:
+        void start(std::size_t threads) {
+            if (threads == 0) {
+                const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+                threads = hardware > 1 ? hardware - 1 : 0;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = false;
+            for (std::size_t i = 0; i < threads; i++) {
+                workers.emplace_back([this] { workerLoop(); });
+            }
+        }
+
+        void stop() {
+            std::vector<std::thread> joining;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+                joining.swap(workers);
+            }
+            wake.notify_all();
+            for (auto &worker: joining) {
+                worker.join();
+            }
+        }
+
+        void workerLoop() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    wake.wait(lock, [this] { return stopping || !tasks.empty(); });
+                    if (stopping && tasks.empty()) return;
+                    task = std::move(tasks.front());
+                    tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()> > tasks;
+        mutable std::mutex mutex;
+        std::condition_variable wake;
+        bool stopping = false;
+        std::size_t active = 0; // parallelFor calls in progress
+        bool resizing = false;
+    };
+}
+
+#endif //ENGINE_THREADPOOL_H
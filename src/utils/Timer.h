@@ -5,4 +5,21 @@
 #ifndef ENGINE_TIMER_H
 #define ENGINE_TIMER_H
 
-#endif //ENGINE_TIMER_H
\ No newline at end of file
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace engine::utils {
+    // Monotonic time in nanoseconds, comparable across threads (e.g. Frame::arrival)
+    inline int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    inline double millisecondsSince(const int64_t start) {
+        return static_cast<double>(nowNanos() - start) / 1e6;
+    }
+}
+
+#endif //ENGINE_TIMER_H
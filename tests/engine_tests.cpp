@@ -2,165 +2,1483 @@
 // Created by HuyN on 25/12/2025.
 //
 
+// Headless checks, no display needed:
+//   engine_tests                 every optimised kernel and stage is compared bit for bit with the
+//                                scalar reference, on clips generated in-process; fingerprints,
+//                                Expected, Config parsing, input sources and the frame cache are
+//                                checked for their behaviour, and the decode paths on the small
+//                                clips in tests/data
+//   engine_tests --perf          throughput of the optimised paths; fails if one is slower than
+//                                --min-speedup times the scalar path or, with --baseline FILE, more
+//                                than --tolerance below the recorded throughput
+//   --write-baseline FILE        records the measured throughput for later --baseline runs
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
-#include <windows.h>
-#include <shlobj.h>
-#include <commdlg.h>
-#include <iostream>
-
+#include "backend/cpu/Kernels.h"
+#include "engine/Backend.h"
+#include "engine/Compositor.h"
+#include "engine/Config.h"
 #include "engine/Engine.h"
+#include "engine/Error.h"
+#include "engine/Filters.h"
+#include "engine/Fingerprint.h"
 #include "engine/Frame.h"
+#include "engine/FrameRing.h"
+#include "engine/Pipeline.h"
+#include "engine/SceneAnalyzer.h"
+#include "engine/TemporalDenoiser.h"
+#include "engine/Tiles.h"
 #include "io/Decoder.h"
+#include "io/FrameCache.h"
+#include "io/Fingerprinter.h"
+#include "io/InputSource.h"
+#include "io/KeyframeSampler.h"
+#include "io/Thumbnailer.h"
 #include "utils/Logger.h"
+#include "utils/ThreadPool.h"
+#include "utils/Timer.h"
 
-namespace io = engine::io;
-
-char *openFileDialog() {
-    OPENFILENAME ofn;
-    char szFile[260] = {0};
-    ZeroMemory(&ofn, sizeof(ofn));
-    ofn.lStructSize = sizeof(ofn);
-    ofn.hwndOwner = nullptr;
-    ofn.lpstrFile = szFile;
-    ofn.nMaxFile = sizeof(szFile);
-    ofn.lpstrFilter = "All Files (*.*)\0*.*\0";
-    ofn.nFilterIndex = 1;
-    ofn.lpstrFileTitle = nullptr;
-    ofn.nMaxFileTitle = 0;
-    ofn.lpstrInitialDir = nullptr;
-    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST | OFN_NOCHANGEDIR;
-
-    if (GetOpenFileName(&ofn) == TRUE) {
-        return _strdup(ofn.lpstrFile);
-    }
-    return nullptr;
-}
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+namespace cpu = engine::cpu;
+namespace logger = engine::utils::Logger;
+
+using engine::Frame;
+using engine::PixelFormat;
+
+namespace {
+    // ctest treats this exit code as "skipped" (SKIP_RETURN_CODE)
+    constexpr int kSkipped = 77;
+
+#ifdef NDEBUG
+    constexpr bool kDebugBuild = false;
+#else
+    constexpr bool kDebugBuild = true;
+#endif
+
+    // =====================
+    // Generated clips
+    // =====================
+
+    class Random {
+    public:
+        explicit Random(const uint32_t seed) : state(seed ? seed : 1) {
+        }
+
+        uint32_t next() {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+        }
+
+        uint8_t byte() {
+            return static_cast<uint8_t>(next() >> 24);
+        }
+
+    private:
+        uint32_t state;
+    };
 
+    // Frames with what the kernels are sensitive to: smooth gradients, a moving hard edge, flat areas,
+    // sensor-like noise and, for RGBA32, alpha covering 0, 255 and everything in between
+    std::vector<Frame> makeClip(const int width, const int height, const PixelFormat format, const int frames,
+                                const uint32_t seed) {
+        Random random(seed);
+        std::vector<Frame> clip;
+        clip.reserve(frames);
 
-engine::Frame randomColorFrameCreate_RGB24(const int width, const int height) {
-    engine::Frame frame(width, height, engine::PixelFormat::RGB24);
-    int bytesPerPixel = frame.bytesPerPixel();
+        for (int f = 0; f < frames; f++) {
+            Frame frame(width, height, format);
+            frame.pts = f;
+            const int bytesPerPixel = frame.bytesPerPixel();
+            const int boxX = (f * 7) % std::max(width, 1);
+            const int boxY = (f * 3) % std::max(height, 1);
 
-    for (int y = 0; y < frame.height; y++) {
-        uint8_t *row = frame.row(y);
-        for (int x = 0; x < frame.width; x++) {
-            row[x * bytesPerPixel + 0] = static_cast<uint8_t>((x * 255) / frame.width);
-            row[x * bytesPerPixel + 1] = static_cast<uint8_t>((y * 255) / frame.height);
-            row[x * bytesPerPixel + 2] = static_cast<uint8_t>(128);
+            for (int y = 0; y < height; y++) {
+                uint8_t *row = frame.row(y);
+                for (int x = 0; x < width; x++) {
+                    const bool inBox = x >= boxX && x < boxX + width / 4 && y >= boxY && y < boxY + height / 4;
+                    for (int c = 0; c < bytesPerPixel; c++) {
+                        int value = (x * (c + 1) * 255) / std::max(width, 1) + (y * 255) / std::max(height, 1) + f;
+                        if (inBox) value = c == 0 ? 255 : 0;
+                        if (y % 16 == 15) value = 128;
+                        value += static_cast<int>(random.byte() % 9) - 4;
+                        row[x * bytesPerPixel + c] = static_cast<uint8_t>(std::clamp(value, 0, 255));
+                    }
+                    if (format == PixelFormat::RGBA32) {
+                        const uint32_t pick = random.next() % 8;
+                        row[x * 4 + 3] = pick == 0 ? 0 : pick == 1 ? 255 : random.byte();
+                    }
+                }
+            }
+            clip.push_back(std::move(frame));
         }
+        return clip;
     }
 
-    return frame;
-}
+    // Smooth RGB24 picture in one of a few unrelated layouts (waves, a blob, a grid), for checks that
+    // need different content rather than different noise
+    Frame makeScene(const int width, const int height, const int kind) {
+        Frame frame(width, height, PixelFormat::RGB24);
+        for (int y = 0; y < height; y++) {
+            uint8_t *row = frame.row(y);
+            for (int x = 0; x < width; x++) {
+                const double u = static_cast<double>(x) / width;
+                const double v = static_cast<double>(y) / height;
+                double level;
+                switch (kind) {
+                    case 0: level = 0.5 + 0.5 * std::sin(6 * u + 3 * v);
+                        break;
+                    case 1: level = std::exp(-12 * ((u - 0.3) * (u - 0.3) + (v - 0.6) * (v - 0.6)));
+                        break;
+                    default: level = 0.5 + 0.5 * std::cos(10 * u) * std::cos(4 * v);
+                        break;
+                }
+                for (int c = 0; c < 3; c++) {
+                    const int value = static_cast<int>(level * (200 + c * 20)) + (x * 7 + y * 13) % 5;
+                    row[x * 3 + c] = static_cast<uint8_t>(std::clamp(value, 0, 255));
+                }
+            }
+        }
+        return frame;
+    }
 
-engine::Frame randomColorFrameCreate_RGBA32(const int width, const int height) {
-    engine::Frame frame(width, height, engine::PixelFormat::RGBA32);
-    int bytesPerPixel = frame.bytesPerPixel();
+    void append(std::vector<uint8_t> &out, const engine::ConstFrameView frame) {
+        for (int y = 0; y < frame.height; y++) {
+            out.insert(out.end(), frame.row(y), frame.row(y) + frame.rowBytes());
+        }
+    }
 
-    for (int y = 0; y < frame.height; y++) {
-        uint8_t *row = frame.row(y);
-        for (int x = 0; x < frame.width; x++) {
-            row[x * bytesPerPixel + 0] = static_cast<uint8_t>((x * 255) / frame.width);
-            row[x * bytesPerPixel + 1] = static_cast<uint8_t>((y * 255) / frame.height);
-            row[x * bytesPerPixel + 2] = static_cast<uint8_t>(128);
-            row[x * bytesPerPixel + 3] = static_cast<uint8_t>(255);
+    template<typename T>
+    void appendValue(std::vector<uint8_t> &out, const T &value) {
+        const auto *bytes = reinterpret_cast<const uint8_t *>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // =====================
+    // Bit-exactness
+    // =====================
+
+    int checks = 0;
+    int failures = 0;
+
+    std::vector<cpu::SimdLevel> optimisedLevels() {
+        std::vector<cpu::SimdLevel> levels;
+        if (cpu::detectSimdLevel() >= cpu::SimdLevel::AVX2) levels.push_back(cpu::SimdLevel::AVX2);
+        return levels;
+    }
+
+    const char *levelName(const cpu::SimdLevel level) {
+        return level == cpu::SimdLevel::AVX2 ? "avx2" : "scalar";
+    }
+
+    // Runs fn(out) at the scalar level and at every optimised level the CPU has; the outputs must match
+    void compareLevels(const std::string &name, const std::function<void(std::vector<uint8_t> &)> &fn) {
+        std::vector<uint8_t> reference, optimised;
+        cpu::setSimdLevel(cpu::SimdLevel::Scalar);
+        fn(reference);
+
+        for (const cpu::SimdLevel level: optimisedLevels()) {
+            cpu::setSimdLevel(level);
+            optimised.clear();
+            fn(optimised);
+
+            checks++;
+            if (optimised == reference) continue;
+
+            failures++;
+            const auto mismatch = std::mismatch(reference.begin(), reference.end(), optimised.begin(),
+                                                optimised.end());
+            const auto index = mismatch.first - reference.begin();
+            logger::error("{} [{}]: output differs from scalar at byte {} of {} ({} vs {})", name, levelName(level),
+                          index, reference.size(), mismatch.first != reference.end() ? *mismatch.first : -1,
+                          mismatch.second != optimised.end() ? *mismatch.second : -1);
         }
+        cpu::setSimdLevel(cpu::detectSimdLevel());
     }
 
-    return frame;
-}
+    // Behaviour checks, for what has no scalar reference to compare with
+    void expect(const bool ok, const std::string &what) {
+        checks++;
+        if (ok) return;
+        failures++;
+        logger::error("{}: check failed", what);
+    }
+
+    // Row lengths around every vector width and tail case, plus one long odd row
+    const std::vector<int> &rowLengths() {
+        static const std::vector<int> lengths = [] {
+            std::vector<int> l;
+            for (int n = 1; n <= 40; n++) l.push_back(n);
+            for (const int n: {63, 64, 65, 95, 96, 97, 127, 128, 129, 255, 256, 1283}) l.push_back(n);
+            return l;
+        }();
+        return lengths;
+    }
+
+    void checkRowKernels() {
+        constexpr int kWidth = 1290;
+        const auto gray = makeClip(kWidth, 72, PixelFormat::GRAY8, cpu::kMaxHistory + 1, 1);
+        const auto rgb = makeClip(kWidth, 8, PixelFormat::RGB24, 2, 2);
+        const auto rgba = makeClip(kWidth, 8, PixelFormat::RGBA32, 2, 3);
+
+        // Rows start one byte into the frame so the vector loads are unaligned
+        const uint8_t *a = gray[0].row(5) + 1;
+        const uint8_t *b = gray[1].row(5) + 1;
+
+        for (const int n: rowLengths()) {
+            const std::string at = " n=" + std::to_string(n);
+
+            compareLevels("sad" + at, [&](auto &out) {
+                appendValue(out, cpu::sad(a, b, n));
+            });
+
+            for (const double sigma: {0.5, 1.5, 4.0}) {
+                const auto kernel = engine::Kernel1D::gaussian(sigma);
+                const int taps = static_cast<int>(kernel.weights.size());
+                compareLevels("weightedSum taps=" + std::to_string(taps) + at, [&](auto &out) {
+                    const uint8_t *sources[cpu::kMaxTaps];
+                    for (int k = 0; k < taps; k++) sources[k] = gray[0].row(k) + 1;
+                    out.resize(n);
+                    cpu::weightedSum(sources, kernel.weights.data(), taps, out.data(), n);
+                });
+            }
+            compareLevels("weightedSum taps=max" + at, [&](auto &out) {
+                const auto kernel = engine::Kernel1D::box(cpu::kMaxTaps / 2);
+                const uint8_t *sources[cpu::kMaxTaps];
+                for (int k = 0; k < cpu::kMaxTaps; k++) sources[k] = gray[0].row(k) + 1;
+                out.resize(n);
+                cpu::weightedSum(sources, kernel.weights.data(), cpu::kMaxTaps, out.data(), n);
+            });
+
+            for (const int amount: {0, 8, 37, 128}) {
+                compareLevels("unsharp amount=" + std::to_string(amount) + at, [&](auto &out) {
+                    out.resize(n);
+                    cpu::unsharp(a, b, amount, out.data(), n);
+                });
+            }
+
+            compareLevels("sobel" + at, [&](auto &out) {
+                out.resize(n);
+                cpu::sobel(gray[0].row(4) + 1, gray[0].row(5) + 1, gray[0].row(6) + 1, out.data(), n);
+            });
+
+            for (const int history: {1, 4, cpu::kMaxHistory}) {
+                for (const int threshold: {1, 12, 255}) {
+                    compareLevels("temporalBlend history=" + std::to_string(history) + " threshold=" +
+                                  std::to_string(threshold) + at, [&](auto &out) {
+                        const uint8_t *frames[cpu::kMaxHistory];
+                        for (int h = 0; h < history; h++) frames[h] = gray[h + 1].row(5) + 1;
+                        out.resize(n);
+                        cpu::temporalBlend(a, frames, history, threshold, out.data(), n);
+                    });
+                }
+            }
+
+            for (const auto *clip: {&rgb, &rgba}) {
+                const int bytesPerPixel = (*clip)[0].bytesPerPixel();
+                compareLevels("grayInPlace bpp=" + std::to_string(bytesPerPixel) + at, [&](auto &out) {
+                    out.assign((*clip)[0].row(1), (*clip)[0].row(1) + n * bytesPerPixel);
+                    cpu::grayInPlace(out.data(), bytesPerPixel, n);
+                });
+            }
+
+            compareLevels("rgbToRgba" + at, [&](auto &out) {
+                out.resize(static_cast<size_t>(n) * 4);
+                cpu::rgbToRgba(rgb[0].row(1) + 3, out.data(), n);
+            });
+
+            compareLevels("rgbaToRgb" + at, [&](auto &out) {
+                out.resize(static_cast<size_t>(n) * 3);
+                cpu::rgbaToRgb(rgba[0].row(1) + 4, out.data(), n);
+            });
+
+            for (const int bytesPerPixel: {3, 4}) {
+                compareLevels("grayToRgb bpp=" + std::to_string(bytesPerPixel) + at, [&](auto &out) {
+                    out.resize(static_cast<size_t>(n) * bytesPerPixel);
+                    cpu::grayToRgb(a, bytesPerPixel, out.data(), n);
+                });
+            }
+
+            for (const auto *clip: {&rgb, &rgba}) {
+                const int bytesPerPixel = (*clip)[0].bytesPerPixel();
+                compareLevels("lumaFromRGB bpp=" + std::to_string(bytesPerPixel) + at, [&](auto &out) {
+                    out.resize(n);
+                    cpu::lumaFromRGB((*clip)[0].row(2) + 1, bytesPerPixel, out.data(), n);
+                });
+            }
+
+            // Bilinear tables from a narrower and a wider source row, the way Engine::resize builds them
+            for (const int sourceWidth: {std::max(2, n / 3), std::min(2 * n + 1, kWidth - 2)}) {
+                std::vector<int32_t> offsets(n);
+                std::vector<uint16_t> weights(n);
+                for (int x = 0; x < n; x++) {
+                    const double position = std::clamp((x + 0.5) * sourceWidth / n - 0.5, 0.0, sourceWidth - 1.0);
+                    const int left = std::min(static_cast<int>(position), sourceWidth - 2);
+                    offsets[x] = left;
+                    weights[x] = static_cast<uint16_t>(std::lround((position - left) * 256));
+                }
+                for (const auto *clip: {&gray, &rgb, &rgba}) {
+                    const int bytesPerPixel = (*clip)[0].bytesPerPixel();
+                    std::vector<int32_t> byteOffsets(offsets);
+                    for (int32_t &offset: byteOffsets) offset *= bytesPerPixel;
+                    compareLevels("resizeRow bpp=" + std::to_string(bytesPerPixel) + " from=" +
+                                  std::to_string(sourceWidth) + at, [&](auto &out) {
+                        out.resize(static_cast<size_t>(n) * bytesPerPixel);
+                        cpu::resizeRow((*clip)[0].row(3) + 1, bytesPerPixel, byteOffsets.data(), weights.data(),
+                                       out.data(), n);
+                    });
+                }
+            }
+
+            compareLevels("premultiply" + at, [&](auto &out) {
+                out.resize(static_cast<size_t>(n) * 4);
+                cpu::premultiply(rgba[0].row(1) + 4, out.data(), n);
+            });
+
+            std::vector<uint8_t> overlay(static_cast<size_t>(n) * 4);
+            cpu::scalar::premultiply(rgba[1].row(2), overlay.data(), n);
+            for (const auto *clip: {&rgb, &rgba}) {
+                const int bytesPerPixel = (*clip)[0].bytesPerPixel();
+                compareLevels("blendPremultiplied bpp=" + std::to_string(bytesPerPixel) + at, [&](auto &out) {
+                    out.assign((*clip)[0].row(3), (*clip)[0].row(3) + n * bytesPerPixel);
+                    cpu::blendPremultiplied(overlay.data(), out.data(), bytesPerPixel, n);
+                });
+            }
+        }
+    }
+
+    void checkBlockKernels() {
+        const auto gray = makeClip(97, 70, PixelFormat::GRAY8, 3, 10);
+
+        for (const Frame &frame: gray) {
+            for (const auto &[x, y]: {std::pair{0, 0}, std::pair{1, 3}, std::pair{65, 38}}) {
+                compareLevels("dctLowFrequency at " + std::to_string(x) + "," + std::to_string(y), [&](auto &out) {
+                    int32_t coefficients[cpu::kDctTerms * cpu::kDctTerms];
+                    cpu::dctLowFrequency(frame.row(y) + x, frame.stride, coefficients);
+                    for (const int32_t c: coefficients) appendValue(out, c);
+                });
+            }
+        }
+
+        // Extremes: flat black, flat white, and a checkerboard (largest coefficients)
+        for (const int pattern: {0, 1, 2}) {
+            compareLevels("dctLowFrequency pattern=" + std::to_string(pattern), [&](auto &out) {
+                uint8_t block[cpu::kDctBlock * cpu::kDctBlock];
+                for (int i = 0; i < cpu::kDctBlock * cpu::kDctBlock; i++) {
+                    const bool odd = ((i / cpu::kDctBlock) + i) % 2;
+                    block[i] = pattern == 0 ? 0 : pattern == 1 ? 255 : odd ? 255 : 0;
+                }
+                int32_t coefficients[cpu::kDctTerms * cpu::kDctTerms];
+                cpu::dctLowFrequency(block, cpu::kDctBlock, coefficients);
+                for (const int32_t c: coefficients) appendValue(out, c);
+            });
+        }
+    }
+
+    // Whole-frame operations and stages on top of the kernels, on an even and an odd frame size
+    void checkFrameOperations() {
+        for (const auto &[width, height]: {std::pair{640, 360}, std::pair{333, 97}}) {
+            const std::string at = " " + std::to_string(width) + "x" + std::to_string(height);
+            const auto gray = makeClip(width, height, PixelFormat::GRAY8, 12, 4);
+            const auto rgb = makeClip(width, height, PixelFormat::RGB24, 3, 5);
+            const auto rgba = makeClip(width, height, PixelFormat::RGBA32, 3, 6);
+
+            compareLevels("Engine::toGrayScale" + at, [&](auto &out) {
+                Frame frame = rgba[0];
+                (void) engine::Engine::toGrayScale(frame);
+                append(out, frame);
+            });
+
+            {
+                const auto directory = std::filesystem::temp_directory_path();
+                const std::string direct = (directory / "engine_tests_direct.pgm").string();
+                const std::string converted = (directory / "engine_tests_converted.pgm").string();
+                Frame grayed = rgb[0];
+                (void) engine::Engine::toGrayScale(grayed);
+                const bool saved = engine::Engine::savePGM(rgb[0], direct) && engine::Engine::savePGM(grayed, converted);
+                auto contents = [](const std::string &path) {
+                    std::ifstream file(path, std::ios::binary);
+                    return std::string(std::istreambuf_iterator<char>(file), {});
+                };
+                expect(saved && contents(direct) == contents(converted),
+                       "Engine::savePGM" + at + ": same luma as toGrayScale");
+                std::filesystem::remove(direct);
+                std::filesystem::remove(converted);
+            }
+
+            compareLevels("Engine::convertRGB24toRGBA32" + at, [&](auto &out) {
+                Frame dest(width, height, PixelFormat::RGBA32);
+                (void) engine::Engine::convertRGB24toRGBA32(rgb[0], dest);
+                append(out, dest);
+            });
+
+            compareLevels("Engine::resize" + at, [&](auto &out) {
+                for (const auto &[w, h]: {std::pair{width / 3, height / 3}, std::pair{width * 2 - 1, height + 5}}) {
+                    Frame dest(w, h, PixelFormat::RGB24);
+                    (void) engine::Engine::resize(rgb[1], dest);
+                    append(out, dest);
+                }
+            });
+
+            compareLevels("Engine::blend" + at, [&](auto &out) {
+                Frame base = rgb[2];
+                (void) engine::Engine::blend(rgba[1].view(3, 5, width / 2, height / 2), base, -7, height / 3);
+                append(out, base);
+            });
+
+            compareLevels("Filters::gaussianBlur" + at, [&](auto &out) {
+                Frame frame = rgb[0];
+                (void) engine::Filters::gaussianBlur(frame, 2.0);
+                (void) engine::Filters::gaussianBlur(frame.view(11, 7, width / 2, height / 2), 6.0);
+                append(out, frame);
+            });
+
+            compareLevels("Filters::unsharpMask" + at, [&](auto &out) {
+                Frame frame = gray[0];
+                (void) engine::Filters::unsharpMask(frame, 1.5, 0.8);
+                append(out, frame);
+            });
+
+            compareLevels("Filters::sobel" + at, [&](auto &out) {
+                Frame edges;
+                (void) engine::Filters::sobel(gray[1], edges);
+                append(out, edges);
+            });
+
+            compareLevels("Compositor" + at, [&](auto &out) {
+                engine::Compositor compositor;
+                (void) compositor.addOverlay(rgba[2], width / 5, -3);
+                (void) compositor.addOverlay(rgba[0].view(0, 0, 37, 19), 1, 1);
+                Frame base = rgba[1];
+                (void) compositor.composite(base);
+                append(out, base);
+            });
+
+            compareLevels("TemporalDenoiser" + at, [&](auto &out) {
+                engine::TemporalDenoiser denoiser({8, 20});
+                for (Frame frame: gray) {
+                    (void) denoiser.process(frame);
+                    append(out, frame);
+                }
+            });
+
+            compareLevels("perceptualHash" + at, [&](auto &out) {
+                for (const Frame &frame: rgb) appendValue(out, engine::perceptualHash(frame).valueOr(0));
+                appendValue(out, engine::perceptualHash(gray[0].view(5, 9, 31, 17)).valueOr(0));
+            });
+
+            compareLevels("SceneAnalyzer" + at, [&](auto &out) {
+                engine::SceneAnalyzer analyzer;
+                for (const Frame &frame: rgb) {
+                    const engine::FrameAnalysis analysis = analyzer.analyze(frame).valueOr({});
+                    appendValue(out, analysis.meanAbsDiff);
+                    appendValue(out, analysis.histogramDistance);
+                    appendValue(out, analysis.sceneCut);
+                }
+            });
+        }
+    }
+
+    // The hash has to work as a fingerprint: stable under rescaling and brightness changes, far apart
+    // for different pictures, and signatures have to survive a file round trip
+    void checkFingerprints() {
+        std::vector<uint64_t> scenes;
+        for (int kind = 0; kind < 3; kind++) {
+            const Frame scene = makeScene(640, 360, kind);
+            const uint64_t hash = engine::perceptualHash(scene).valueOr(0);
+            scenes.push_back(hash);
+            const std::string name = "perceptualHash scene " + std::to_string(kind);
+
+            Frame smaller(320, 180, PixelFormat::RGB24);
+            (void) engine::Engine::resize(scene, smaller);
+            Frame brighter = scene;
+            for (uint8_t &value: brighter.data) value = static_cast<uint8_t>(std::min(value + 12, 255));
+
+            expect((hash & 1) == 0, name + ": DC bit clear");
+            expect(engine::hammingDistance(hash, engine::perceptualHash(smaller).valueOr(~hash)) <= 8,
+                   name + ": rescaled copy within 8 bits");
+            expect(engine::hammingDistance(hash, engine::perceptualHash(brighter).valueOr(~hash)) <= 8,
+                   name + ": brightened copy within 8 bits");
+        }
+        for (std::size_t i = 0; i < scenes.size(); i++) {
+            for (std::size_t j = i + 1; j < scenes.size(); j++) {
+                expect(engine::hammingDistance(scenes[i], scenes[j]) >= 20,
+                       "perceptualHash: scenes " + std::to_string(i) + " and " + std::to_string(j) + " 20+ bits apart");
+            }
+        }
+        expect(engine::perceptualHash(Frame()).is(engine::ErrorCode::UnsupportedFormat) ||
+               engine::perceptualHash(Frame()).is(engine::ErrorCode::InvalidArgument), "perceptualHash: empty frame");
+
+        // A 6 s video at 4 fps, 2 s per scene, hashed once a second; and its middle third
+        engine::FrameHasher hasher(1.0, [](const int64_t pts) { return static_cast<double>(pts) / 4; });
+        for (int i = 0; i < 24; i++) {
+            Frame frame = makeScene(160, 90, i / 8);
+            frame.pts = i;
+            (void) hasher.process(frame);
+        }
+        const engine::Signature &full = hasher.signature();
+        expect(full.hashes.size() == 6, "FrameHasher: one hash per second");
+        engine::Signature trimmed;
+        trimmed.hashes.assign(full.hashes.begin() + 2, full.hashes.begin() + 4);
+        expect(trimmed.distance(full) == 0, "Signature::distance: trimmed copy");
+        engine::Signature other;
+        other.hashes = {{0, scenes[1] ^ 0xAAAAAAAAAAAAAAAAULL}};
+        expect(other.distance(full) >= 16, "Signature::distance: unrelated signature");
+        expect(engine::Signature().distance(full) == 64, "Signature::distance: empty signature");
+
+        const std::string path = (std::filesystem::temp_directory_path() / "engine_tests_signature.vpfp").string();
+        expect(static_cast<bool>(full.save(path)), "Signature::save");
+        const auto loaded = engine::Signature::load(path);
+        bool same = loaded && loaded->hashes.size() == full.hashes.size();
+        for (std::size_t i = 0; same && i < full.hashes.size(); i++) {
+            same = loaded->hashes[i].hash == full.hashes[i].hash &&
+                   std::abs(loaded->hashes[i].time - full.hashes[i].time) < 1e-3;
+        }
+        expect(same, "Signature::load: round trip");
+
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 5);
+        expect(engine::Signature::load(path).is(engine::ErrorCode::CorruptData), "Signature::load: truncated file");
+        std::filesystem::remove(path);
+        expect(engine::Signature::load(path).is(engine::ErrorCode::IOFailure), "Signature::load: missing file");
+    }
+
+    // True if fn throws a std::exception
+    bool throws(const std::function<void()> &fn) {
+        try {
+            fn();
+        } catch (const std::exception &) {
+            return true;
+        }
+        return false;
+    }
+
+    void checkExpected() {
+        const engine::Expected<int> value = 7;
+        const engine::Expected<int> failed = engine::Error{engine::ErrorCode::IOFailure, "read failed"};
+        expect(value && *value == 7 && value.valueOr(0) == 7, "Expected: value");
+        expect(!failed && failed.valueOr(3) == 3 && failed.is(engine::ErrorCode::IOFailure), "Expected: error");
+        expect(throws([&] { (void) failed.value(); }), "Expected: value() throws on an error");
+
+        // A read loop tells the end of the stream apart from a failure
+        for (const auto code: {engine::ErrorCode::EndOfStream, engine::ErrorCode::CorruptData}) {
+            int remaining = 3;
+            auto read = [&]() -> engine::Expected<void> {
+                if (remaining-- > 0) return {};
+                return engine::Error{code, "stopped"};
+            };
+            int frames = 0;
+            engine::Expected<void> result;
+            while ((result = read())) frames++;
+            expect(frames == 3 && result.is(code) && result.is(engine::ErrorCode::EndOfStream) ==
+                   (code == engine::ErrorCode::EndOfStream), std::string("Expected<void>: loop ends on ") + toString(code));
+        }
+
+        // Pipelines retry TryAgain, end on EndOfStream and throw on failures, with and without a decode thread
+        for (const int depth: {0, 2}) {
+            engine::Config config;
+            config.queueDepth = depth;
+            engine::Pipeline pipeline(config);
+            const std::string name = "Pipeline queue_depth=" + std::to_string(depth);
+
+            int calls = 0;
+            const auto delivered = pipeline.run(8, 8, PixelFormat::GRAY8, [&](Frame &frame) -> engine::Expected<void> {
+                if (++calls > 12) return engine::Error{engine::ErrorCode::EndOfStream, "end"};
+                if (calls % 3 == 0) return engine::Error{engine::ErrorCode::TryAgain, "no data yet"};
+                frame.pts = calls;
+                return {};
+            }, [](Frame &) {});
+            expect(delivered == 8, name + ": TryAgain is retried, EndOfStream ends the run");
+
+            expect(throws([&] {
+                pipeline.run(8, 8, PixelFormat::GRAY8, [](Frame &) -> engine::Expected<void> {
+                    return engine::Error{engine::ErrorCode::IOFailure, "input gone"};
+                }, [](Frame &) {});
+            }), name + ": a failing source throws");
+
+            pipeline.emplace<engine::TemporalDenoiser>();
+            expect(throws([&] {
+                pipeline.run(8, 8, PixelFormat::UNKNOWN, [](Frame &) -> engine::Expected<void> { return {}; },
+                             [](Frame &) {});
+            }), name + ": a failing stage throws");
+        }
+
+        // A sink that throws while the source thread is blocked on stalled live input: the interrupt hook
+        // has to unblock it, or run() never returns
+        for (const bool lowLatency: {false, true}) {
+            engine::Config config;
+            config.queueDepth = 2;
+            config.lowLatency = lowLatency;
+            engine::Pipeline pipeline(config);
+
+            engine::io::StreamingSource live;
+            const uint8_t packet = 1;
+            live.append(&packet, 1); // one frame's worth, then nothing
+            uint8_t byte = 0;
+            expect(throws([&] {
+                pipeline.run(8, 8, PixelFormat::GRAY8, [&](Frame &) -> engine::Expected<void> {
+                    if (live.read(&byte, 1) < 0) return engine::Error{engine::ErrorCode::IOFailure, "interrupted"};
+                    return {};
+                }, [](Frame &) { throw std::runtime_error("sink failed"); }, [&] { live.interrupt(); });
+            }), std::string("Pipeline") + (lowLatency ? " low_latency" : " queue_depth=2") +
+                ": interrupt unblocks the source when the sink throws");
+        }
+    }
+
+    double meanAbsDifference(const engine::ConstFrameView a, const engine::ConstFrameView b) {
+        uint64_t sum = 0;
+        for (int y = 0; y < a.height; y++) {
+            sum += cpu::sad(a.row(y), b.row(y), a.rowBytes());
+        }
+        return static_cast<double>(sum) / std::max<int64_t>(static_cast<int64_t>(a.rowBytes()) * a.height, 1);
+    }
 
-/*
-62
-#     #              #     #
-#     # #    # #   # ##    #
-#     # #    #  # #  # #   #
-####### #    #   #   #  #  #
-#     # #    #   #   #   # #
-#     # #    #   #   #    ##
-#     #  ####    #   #     # 125
-
- */
-
-// Add blueMark
-void addBlueMark(engine::Frame &frame) {
-    if (frame.pixelFormat != engine::PixelFormat::RGBA32) {
-        engine::utils::Logger::error("addBlueMark: pixelFormat not supported.");
-        return;
-    }
-
-    const std::vector<std::vector<int> > bitmap = {
-        {1, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 1, 0, 1, 1, 0, 0, 0, 0, 1},
-        {1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 1, 0, 0, 0, 1},
-        {1, 1, 1, 1, 1, 1, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 0, 0, 1},
-        {1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 1},
-        {1, 0, 0, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1},
-        {1, 0, 0, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1, 0, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1}
+    // Straightforward separable convolution with replicated edges, the same Q8 rounding per pass
+    Frame referenceConvolve(const Frame &src, const engine::Kernel1D &kernel) {
+        const int radius = kernel.radius();
+        const int bytesPerPixel = src.bytesPerPixel();
+        auto pass = [&](const Frame &in, const bool vertical) {
+            Frame out(in.width, in.height, in.pixelFormat);
+            for (int y = 0; y < in.height; y++) {
+                for (int x = 0; x < in.width; x++) {
+                    for (int c = 0; c < bytesPerPixel; c++) {
+                        uint32_t sum = 128;
+                        for (int k = -radius; k <= radius; k++) {
+                            const int sx = vertical ? x : std::clamp(x + k, 0, in.width - 1);
+                            const int sy = vertical ? std::clamp(y + k, 0, in.height - 1) : y;
+                            sum += kernel.weights[k + radius] * in.row(sy)[sx * bytesPerPixel + c];
+                        }
+                        out.row(y)[x * bytesPerPixel + c] = static_cast<uint8_t>(sum >> 8);
+                    }
+                }
+            }
+            return out;
+        };
+        return pass(pass(src, false), true);
+    }
+
+    // What the stages do, beyond agreeing with their scalar reference
+    void checkStages() {
+        // Filters::convolve on a region several bands high matches the plain two-pass filter, across the
+        // band boundaries, and leaves the rest of the frame alone
+        Frame wide(2048, 100, PixelFormat::RGBA32);
+        Random noise(11);
+        for (uint8_t &value: wide.data) value = noise.byte();
+        const Frame before = wide;
+        const engine::Kernel1D kernel = engine::Kernel1D::gaussian(1.5);
+        const Frame expected = referenceConvolve(Frame(before.view(5, 3, 2040, 95)), kernel);
+        bool matches = static_cast<bool>(engine::Filters::convolve(wide.view(5, 3, 2040, 95), kernel));
+        for (int y = 0; y < wide.height; y++) {
+            for (int x = 0; x < wide.width; x++) {
+                const bool inside = x >= 5 && x < 2045 && y >= 3 && y < 98;
+                const uint8_t *pixel = wide.row(y) + x * 4;
+                const uint8_t *want = inside ? expected.row(y - 3) + (x - 5) * 4 : before.row(y) + x * 4;
+                matches = matches && std::memcmp(pixel, want, 4) == 0;
+            }
+        }
+        expect(matches, "Filters::convolve: banded in-place result matches the two-pass reference");
+
+        // FrameRing: the newest historyFrames frames, by age, after the slots have wrapped around
+        engine::FrameRing ring(3, 4, 2, PixelFormat::GRAY8);
+        for (int f = 0; f < 5; f++) {
+            for (int y = 0; y < 2; y++) std::fill_n(ring.writeRow(y), 4, static_cast<uint8_t>(f));
+            ring.commit(f * 10);
+        }
+        bool ordered = ring.size() == 3;
+        for (int age = 0; age < 3; age++) {
+            ordered = ordered && ring.row(age, 1)[3] == 4 - age && ring.pts(age) == (4 - age) * 10 &&
+                      ring.writeRow(1) != ring.row(age, 1);
+        }
+        expect(ordered, "FrameRing: wraparound keeps the newest frames in age order");
+        expect(ring.configure(3, 4, 2, PixelFormat::GRAY8) && ring.size() == 3,
+               "FrameRing::configure: same geometry keeps the history");
+        expect(ring.configure(3, 6, 2, PixelFormat::GRAY8) && ring.size() == 0,
+               "FrameRing::configure: new geometry clears the history");
+        expect(ring.configure(0, 6, 2, PixelFormat::GRAY8).is(engine::ErrorCode::InvalidArgument),
+               "FrameRing::configure: rejects an empty history");
+
+        // TemporalDenoiser: noise on a static picture goes down, a cut passes through untouched
+        const Frame clean = makeScene(96, 64, 0);
+        engine::TemporalDenoiser denoiser({4, 24});
+        Random random(7);
+        double noisyError = 0, denoisedError = 0;
+        for (int f = 0; f < 8; f++) {
+            Frame frame = clean;
+            for (uint8_t &value: frame.data) {
+                value = static_cast<uint8_t>(std::clamp(value + static_cast<int>(random.byte() % 17) - 8, 0, 255));
+            }
+            noisyError = meanAbsDifference(frame, clean);
+            (void) denoiser.process(frame);
+            denoisedError = meanAbsDifference(frame, clean);
+        }
+        expect(denoisedError < 0.6 * noisyError, "TemporalDenoiser: reduces noise on a static clip");
+        Frame cut = clean;
+        for (uint8_t &value: cut.data) value ^= 0x80; // every sample ~128 away from its history
+        const Frame original = cut;
+        (void) denoiser.process(cut);
+        expect(cut.data == original.data, "TemporalDenoiser: leaves a scene cut alone");
+
+        // forEachTile: every pixel of the region is in exactly one tile, edge tiles are clipped
+        Frame tiled(100, 70, PixelFormat::GRAY8);
+        std::atomic<int> tiles = 0;
+        const auto visited = engine::forEachTile(tiled.view(10, 5, 83, 61), 16, 16, [&](const engine::FrameView tile) {
+            tiles++;
+            for (int y = 0; y < tile.height; y++) {
+                for (int x = 0; x < tile.rowBytes(); x++) tile.row(y)[x]++;
+            }
+        });
+        bool once = visited && tiles == 6 * 4;
+        for (int y = 0; y < tiled.height; y++) {
+            for (int x = 0; x < tiled.width; x++) {
+                const bool inside = x >= 10 && x < 93 && y >= 5 && y < 66;
+                once = once && tiled.row(y)[x] == (inside ? 1 : 0);
+            }
+        }
+        expect(once, "forEachTile: covers the region once and nothing outside it");
+        std::atomic<int> counted = 0;
+        const auto readOnly = engine::forEachTile(tiled, 64, 64, [&](const engine::ConstFrameView tile) {
+            int sum = 0;
+            for (int y = 0; y < tile.height; y++) {
+                for (int x = 0; x < tile.width; x++) sum += tile.row(y)[x];
+            }
+            counted += sum;
+        });
+        expect(readOnly && counted == 83 * 61, "forEachTile: read-only tiles of a frame");
+        expect(engine::forEachTile(std::as_const(tiled), 0, 8, [](engine::ConstFrameView) {
+        }).is(engine::ErrorCode::InvalidArgument), "forEachTile: rejects an empty tile size");
+
+        // Engine::blend and a Compositor overlay share one blend path: same pixels, also when clipped
+        for (const PixelFormat format: {PixelFormat::RGB24, PixelFormat::RGBA32}) {
+            Frame overlay(70, 40, PixelFormat::RGBA32);
+            for (uint8_t &value: overlay.data) value = noise.byte();
+            Frame direct(96, 64, format);
+            for (uint8_t &value: direct.data) value = noise.byte();
+            Frame composited = direct;
+
+            (void) engine::Engine::blend(overlay, direct, -9, 30);
+            engine::Compositor layers;
+            (void) layers.addOverlay(overlay, -9, 30);
+            (void) layers.composite(composited);
+            expect(direct.data == composited.data, std::string("Engine::blend: matches Compositor on ") +
+                                                   (format == PixelFormat::RGB24 ? "RGB24" : "RGBA32"));
+        }
+
+        // SceneAnalyzer: the first frame starts a scene, a repeat is a duplicate, slight noise is neither and
+        // a dark unrelated picture is a cut; with dropDuplicates the repeat leaves the pipeline
+        std::vector<engine::FrameAnalysis> events;
+        engine::SceneAnalyzer analyzer({}, [&](const engine::FrameAnalysis &event) { events.push_back(event); });
+        Frame noisy = clean;
+        for (uint8_t &value: noisy.data) value = static_cast<uint8_t>(std::min(value + static_cast<int>(noise.byte() % 3), 255));
+        Frame night = makeScene(96, 64, 1);
+        for (uint8_t &value: night.data) value /= 4;
+        Frame sceneFrames[] = {clean, clean, noisy, night};
+        std::vector<engine::FrameAnalysis> results;
+        for (Frame &frame: sceneFrames) {
+            (void) analyzer.process(frame);
+            results.push_back(analyzer.last());
+        }
+        expect(results[0].sceneCut && !results[0].duplicate, "SceneAnalyzer: the first frame starts a scene");
+        expect(results[1].duplicate && !results[1].sceneCut && results[1].meanAbsDiff == 0,
+               "SceneAnalyzer: flags a repeated frame as a duplicate");
+        expect(!results[2].duplicate && !results[2].sceneCut, "SceneAnalyzer: slight noise is neither");
+        expect(results[3].sceneCut && !results[3].duplicate && results[3].histogramDistance > 0.35,
+               "SceneAnalyzer: flags a hard cut");
+        expect(events.size() == 3 && events[1].index == 1 && events[2].index == 3,
+               "SceneAnalyzer: reports the cuts and the duplicate");
+        engine::SceneAnalyzer dropping({.dropDuplicates = true});
+        Frame repeat = clean;
+        expect(dropping.process(repeat).valueOr(false) && !dropping.process(repeat).valueOr(true),
+               "SceneAnalyzer: dropDuplicates drops the repeat");
+
+        // Compositor: alpha 0 leaves the base, 255 replaces it, half mixes both; nothing outside the overlay
+        for (const PixelFormat format: {PixelFormat::RGB24, PixelFormat::RGBA32}) {
+            for (const int alpha: {0, 128, 255}) {
+                Frame overlay(20, 10, PixelFormat::RGBA32);
+                for (int i = 0; i < 20 * 10; i++) {
+                    const uint8_t pixel[4] = {200, 100, 50, static_cast<uint8_t>(alpha)};
+                    std::memcpy(overlay.data.data() + i * 4, pixel, 4);
+                }
+                Frame base(40, 30, format);
+                const int bytesPerPixel = base.bytesPerPixel();
+                for (int i = 0; i < 40 * 30; i++) {
+                    const uint8_t pixel[4] = {10, 20, 30, 77};
+                    std::memcpy(base.data.data() + i * bytesPerPixel, pixel, bytesPerPixel);
+                }
+                const Frame before = base;
+                engine::Compositor layers;
+                (void) layers.addOverlay(overlay, 5, 8);
+                bool blended = static_cast<bool>(layers.composite(base));
+                for (int y = 0; y < base.height; y++) {
+                    for (int x = 0; x < base.width; x++) {
+                        const bool inside = x >= 5 && x < 25 && y >= 8 && y < 18;
+                        for (int c = 0; c < bytesPerPixel; c++) {
+                            const int was = before.row(y)[x * bytesPerPixel + c];
+                            const int now = base.row(y)[x * bytesPerPixel + c];
+                            if (!inside || c == 3) { // outside the overlay, and the base alpha, are kept
+                                blended = blended && now == was;
+                                continue;
+                            }
+                            const double want = (overlay.data[c] * alpha + was * (255 - alpha)) / 255.0;
+                            blended = blended && std::abs(now - want) <= 1.0;
+                        }
+                    }
+                }
+                expect(blended, "Compositor: alpha " + std::to_string(alpha) + " on " +
+                                (format == PixelFormat::RGB24 ? "RGB24" : "RGBA32"));
+            }
+        }
+
+        // Region-of-interest operations change the view and nothing around it
+        {
+            const auto source = makeClip(64, 48, PixelFormat::RGB24, 1, 12);
+            const Frame original = source[0];
+            auto outsideKept = [&](const Frame &after, const int x0, const int y0, const int w, const int h) {
+                bool kept = true, changed = false;
+                for (int y = 0; y < after.height; y++) {
+                    for (int x = 0; x < after.width; x++) {
+                        const bool inside = x >= x0 && x < x0 + w && y >= y0 && y < y0 + h;
+                        const bool same = std::memcmp(after.row(y) + x * 3, original.row(y) + x * 3, 3) == 0;
+                        kept = kept && (inside || same);
+                        changed = changed || (inside && !same);
+                    }
+                }
+                return kept && changed;
+            };
+
+            Frame frame = original;
+            expect(engine::Engine::toGrayScale(frame.view(7, 5, 30, 20)) && outsideKept(frame, 7, 5, 30, 20),
+                   "Engine::toGrayScale: only the view changes");
+            frame = original;
+            expect(engine::Engine::resize(makeScene(16, 16, 1), frame.view(9, 3, 41, 37)) &&
+                   outsideKept(frame, 9, 3, 41, 37), "Engine::resize: only the destination view changes");
+            frame = original;
+            Frame overlay(50, 50, PixelFormat::RGBA32);
+            std::fill(overlay.data.begin(), overlay.data.end(), uint8_t{255});
+            expect(engine::Engine::blend(overlay, frame.view(20, 10, 15, 12), -5, -5) &&
+                   outsideKept(frame, 20, 10, 15, 12), "Engine::blend: clipped to the view");
+            frame = original;
+            expect(engine::Filters::gaussianBlur(frame.view(3, 30, 50, 15), 2.0) && outsideKept(frame, 3, 30, 50, 15),
+                   "Filters::gaussianBlur: only the view changes");
+            frame = original;
+            expect(engine::Filters::unsharpMask(frame.view(30, 2, 31, 40), 1.5, 1.0) &&
+                   outsideKept(frame, 30, 2, 31, 40), "Filters::unsharpMask: only the view changes");
+        }
+
+        // Bad per-frame input is reported, not thrown
+        Frame unknown(16, 16, PixelFormat::RGB24);
+        unknown.pixelFormat = PixelFormat::UNKNOWN;
+        Frame edges;
+        Frame base = clean;
+        expect(denoiser.process(unknown).is(engine::ErrorCode::UnsupportedFormat) &&
+               engine::SceneAnalyzer().analyze(unknown).is(engine::ErrorCode::UnsupportedFormat) &&
+               engine::Filters::sobel(unknown, edges).is(engine::ErrorCode::UnsupportedFormat) &&
+               engine::Filters::boxBlur(base, 40).is(engine::ErrorCode::InvalidArgument),
+               "Stages: unsupported formats and bad parameters return an error");
+        engine::Compositor compositor;
+        expect(compositor.addOverlay(clean, 0, 0).is(engine::ErrorCode::UnsupportedFormat) &&
+               compositor.moveOverlay(3, 0, 0).is(engine::ErrorCode::InvalidArgument) &&
+               compositor.size() == 0 && compositor.process(base).valueOr(false),
+               "Compositor: bad overlays and unknown ids return an error");
+    }
+
+    void checkConfig() {
+        engine::Config config;
+        config.set("io_buffer_size", "128K");
+        config.set("frame_cache_memory", "1G");
+        config.set("scaler", "Lanczos");
+        config.set("low_latency", "yes");
+        expect(config.ioBufferSize == 128 * 1024 && config.frameCacheMemory == std::size_t{1} << 30 &&
+               config.scaler == engine::ScalerAlgorithm::Lanczos && config.lowLatency, "Config::set: valid values");
+
+        const std::vector<std::pair<std::string, std::string> > invalid = {
+            {"no_such_key", "1"}, {"scaler", "fast"}, {"decoder_threads", "-1"}, {"decoder_threads", "4x"},
+            {"io_buffer_size", "1K"}, {"io_buffer_size", "12Q"}, {"low_latency", "maybe"}, {"simd", "avx512"},
+            {"worker_threads", ""}, {"log_level", "verbose"}
+        };
+        for (const auto &[key, value]: invalid) {
+            expect(throws([&] { engine::Config().set(key, value); }), "Config::set: rejects " + key + " = '" + value + "'");
+        }
+
+        const std::string path = (std::filesystem::temp_directory_path() / "engine_tests_config.txt").string();
+        std::ofstream(path) << "# tuned for 4 cores\nworker_threads = 3   # pool\n\nQUEUE_DEPTH=2\n";
+        const auto loaded = engine::Config::fromFile(path);
+        expect(loaded.workerThreads == 3 && loaded.queueDepth == 2, "Config::fromFile: comments, blanks, key case");
+        std::ofstream(path) << "worker_threads 3\n";
+        expect(throws([&] { (void) engine::Config::fromFile(path); }), "Config::fromFile: rejects a line without =");
+        std::filesystem::remove(path);
+        expect(throws([&] { (void) engine::Config::fromFile(path); }), "Config::fromFile: missing file");
+
+        // apply() checks everything before it changes anything, and unset keys undo earlier overrides
+        engine::Config scalar;
+        scalar.backend = "cpu-scalar";
+        scalar.simd = engine::SimdOverride::Scalar;
+        scalar.logLevel = engine::LogLevel::Warn;
+        scalar.apply();
+        expect(cpu::simdLevel() == cpu::SimdLevel::Scalar && logger::level() == engine::LogLevel::Warn,
+               "Config::apply: simd and log_level");
+        engine::Config unavailable = scalar;
+        unavailable.backend = "no-such-backend";
+        unavailable.logLevel = engine::LogLevel::Error;
+        expect(throws([&] { unavailable.apply(); }) && logger::level() == engine::LogLevel::Warn &&
+               engine::Config::current().logLevel == engine::LogLevel::Warn,
+               "Config::apply: unknown backend rejected before anything is applied");
+        engine::Config().apply();
+        expect(cpu::simdLevel() == cpu::detectSimdLevel() && logger::level() == engine::LogLevel::Info &&
+               std::string(engine::Backend::active().name()) == (optimisedLevels().empty() ? "cpu-scalar" : "cpu-avx2"),
+               "Config::apply: defaults restore automatic backend and SIMD selection");
+
+        // Resizing must not stop the workers under a running parallelFor
+        engine::utils::ThreadPool pool(2);
+        std::atomic<int> refused{0};
+        pool.parallelFor(4, 1, [&](int, int) { refused += pool.resize(1) ? 0 : 1; });
+        expect(refused == 4 && pool.concurrency() == 3, "ThreadPool::resize: refused during parallelFor");
+        expect(pool.resize(1) && pool.concurrency() == 2, "ThreadPool::resize: idle pool");
+    }
+
+    void checkInputSources() {
+        std::vector<uint8_t> bytes(1000);
+        for (std::size_t i = 0; i < bytes.size(); i++) bytes[i] = static_cast<uint8_t>(i * 7);
+        const auto source = engine::io::InputSource::fromBuffer(bytes);
+        std::vector<uint8_t> buffer(1024);
+
+        expect(source->seekable() && source->size() == 1000, "InputSource::fromBuffer: seekable, sized");
+        expect(source->read(buffer.data(), 300) == 300 && std::equal(buffer.begin(), buffer.begin() + 300, bytes.begin()),
+               "InputSource::fromBuffer: read");
+        expect(source->seek(100, SEEK_CUR) == 400, "InputSource::fromBuffer: SEEK_CUR");
+        expect(source->read(buffer.data(), 1024) == 600 && buffer[0] == bytes[400] && buffer[599] == bytes[999],
+               "InputSource::fromBuffer: short read at the end");
+        expect(source->read(buffer.data(), 1024) == 0, "InputSource::fromBuffer: 0 at the end");
+        expect(source->seek(-10, SEEK_END) == 990 && source->read(buffer.data(), 4) == 4 && buffer[0] == bytes[990],
+               "InputSource::fromBuffer: SEEK_END");
+        expect(source->seek(1001, SEEK_SET) < 0 && source->seek(-1, SEEK_SET) < 0,
+               "InputSource::fromBuffer: seeks outside the data fail");
+        expect(source->identity() == source->identity() &&
+               source->identity() != engine::io::InputSource::fromBuffer(bytes)->identity(),
+               "InputSource::identity: unique per source");
+
+        const auto callbacks = engine::io::InputSource::fromCallbacks([](uint8_t *, int) { return 0; });
+        expect(!callbacks->seekable() && callbacks->seek(0, SEEK_SET) < 0, "InputSource::fromCallbacks: no seek callback");
+
+        // Reads return what has arrived so far, and block for the rest until finish()
+        engine::io::StreamingSource stream;
+        stream.append(bytes.data(), 100);
+        expect(stream.read(buffer.data(), 1024) == 100 && stream.size() < 0, "StreamingSource: partial read");
+        std::thread producer([&] {
+            stream.append(bytes.data() + 100, 200);
+            stream.finish();
+        });
+        int total = 0;
+        while (const int count = stream.read(buffer.data() + total, 1024 - total)) total += count;
+        producer.join();
+        expect(total == 200 && buffer[0] == bytes[100] && stream.size() == 300, "StreamingSource: blocks until finish()");
+        expect(stream.seek(0, SEEK_SET) == 0 && stream.read(buffer.data(), 10) == 10 && buffer[9] == bytes[9],
+               "StreamingSource: seek back");
+        stream.fail();
+        expect(stream.read(buffer.data(), 10) < 0, "StreamingSource: fail()");
+
+#ifndef _WIN32
+        // A live pipe hands over what has arrived instead of waiting for the whole buffer
+        int fds[2];
+        if (pipe(fds) == 0) {
+            std::FILE *readEnd = fdopen(fds[0], "rb");
+            const auto piped = engine::io::InputSource::fromPipe(readEnd);
+            expect(write(fds[1], bytes.data(), 10) == 10 && piped->read(buffer.data(), 1024) == 10 &&
+                   buffer[9] == bytes[9], "InputSource::fromPipe: partial read");
+            close(fds[1]);
+            expect(piped->read(buffer.data(), 1024) == 0, "InputSource::fromPipe: 0 once the writer closes");
+            std::fclose(readEnd);
+        }
+#endif
+    }
+
+    void checkFrameCache() {
+        using engine::io::FrameCache;
+        using engine::io::FrameKey;
+        auto makeFrame = [](const int index) {
+            Frame frame(64, 32, PixelFormat::RGB24);
+            std::fill(frame.data.begin(), frame.data.end(), static_cast<uint8_t>(index));
+            frame.pts = index * 10;
+            return frame;
+        };
+        auto key = [](const int pts) { return FrameKey{"clip", PixelFormat::RGB24, 64, 32, pts}; };
+        const std::size_t frameBytes = makeFrame(0).data.size();
+
+        {
+            FrameCache cache({3 * frameBytes, ""});
+            for (int i = 0; i < 3; i++) cache.insert(key(i * 10), 10, makeFrame(i));
+            (void) cache.find(key(0)); // 0 becomes the most recently used, so 1 is evicted next
+            cache.insert(key(30), 10, makeFrame(3));
+
+            const auto hit = cache.find(key(25)); // on screen from pts 20 to 29
+            expect(hit && hit->data[0] == 2 && hit->pts == 20, "FrameCache: lookup within the frame duration");
+            expect(cache.find(key(0)) && !cache.find(key(10)) && cache.find(key(30)), "FrameCache: LRU eviction");
+            expect(!cache.find(key(40)) && !cache.find({"other", PixelFormat::RGB24, 64, 32, 20}),
+                   "FrameCache: misses past the end and for other sources");
+            const auto stats = cache.stats();
+            expect(stats.frames == 3 && stats.memoryBytes == 3 * frameBytes && stats.diskBytes == 0,
+                   "FrameCache: memory budget");
+        }
+
+        const auto directory = std::filesystem::temp_directory_path() / "engine_tests_frame_cache";
+        std::filesystem::remove_all(directory);
+        {
+            FrameCache cache({2 * frameBytes, directory.string()});
+            for (int i = 0; i < 5; i++) cache.insert(key(i * 10), 10, makeFrame(i));
+            expect(cache.stats().diskBytes > 3 * frameBytes, "FrameCache: evicted frames spill to disk");
+
+            const auto reloaded = cache.find(key(5));
+            expect(reloaded && reloaded->data[0] == 0 && reloaded->data.back() == 0 && cache.stats().diskHits == 1,
+                   "FrameCache: spilled frame read back");
+        }
+        {
+            // A new cache on the same directory picks the files up again
+            FrameCache cache({2 * frameBytes, directory.string()});
+            const auto reloaded = cache.find(key(12));
+            expect(reloaded && reloaded->data[0] == 1 && cache.stats().diskHits == 1, "FrameCache: disk tier across runs");
+            cache.clear();
+            expect(std::filesystem::is_empty(directory), "FrameCache::clear: removes the files");
+        }
+        std::filesystem::remove_all(directory);
+    }
+
+    // =====================
+    // Decoding
+    // =====================
+
+    // Fixtures in tests/data: 128x96 at 12 fps, 48 frames, a new scene every 12 frames. The 32x32 block at
+    // the top left of frame k is gray 16 + 4 k, which tells decoded frames apart.
+    //   clip.mkv            mpeg4 -q:v 4 -g 12 -bf 0: a keyframe every second
+    //   clip_reencoded.mkv  clip.mkv decoded and encoded again: mpeg4 -q:v 10 -g 12 -bf 0 at 112x84
+    //   clip_mjpeg.mkv      the first 12 frames as mjpeg -q:v 10, every frame a keyframe, lowres capable
+    std::string fixture(const std::string &name) {
+        return std::string(ENGINE_TEST_DATA) + "/" + name;
+    }
+
+    // Clip frame index shown by a decoded RGB frame, read from the middle of its marker block, which
+    // is blockSize pixels wide at this size
+    int markerIndex(const engine::ConstFrameView frame, const int blockSize) {
+        const int value = frame.row(blockSize / 2)[(blockSize / 2) * frame.bytesPerPixel() + 1];
+        return static_cast<int>(std::lround((value - 16) / 4.0));
+    }
+
+    // Every frame of a decoder opened on clip.mkv, with its time in seconds
+    std::vector<std::pair<Frame, double> > decodeAll(engine::io::Decoder &decoder) {
+        std::vector<std::pair<Frame, double> > frames;
+        Frame frame(128, 96, PixelFormat::RGB24);
+        while (decoder.readFrame_RGB24(frame)) {
+            frames.emplace_back(frame, decoder.toSeconds(frame.pts));
+        }
+        return frames;
+    }
+
+    void checkDecoding() {
+        using engine::io::Decoder;
+        using engine::io::InputSource;
+
+        // Sequential decode: every frame once, in order, with its timestamp
+        Decoder decoder;
+        decoder.open(fixture("clip.mkv"));
+        expect(std::abs(decoder.getDuration() - 4.0) < 0.1 && decoder.getWidth() == 128 && decoder.getHeight() == 96,
+               "Decoder: duration and size");
+        const auto frames = decodeAll(decoder);
+        bool ordered = frames.size() == 48;
+        for (std::size_t k = 0; ordered && k < frames.size(); k++) {
+            ordered = markerIndex(frames[k].first, 32) == static_cast<int>(k) &&
+                      std::abs(frames[k].second - k / 12.0) < 1e-3 && // millisecond Matroska timestamps
+                      (k == 0 || frames[k].first.pts > frames[k - 1].first.pts);
+        }
+        expect(ordered, "Decoder: 48 frames in order with their pts");
+        Frame frame(128, 96, PixelFormat::RGB24);
+        expect(decoder.readFrame_RGB24(frame).is(engine::ErrorCode::EndOfStream), "Decoder: EndOfStream at the end");
+
+        // The same bytes through a custom AVIOContext decode to the same frames, and can seek
+        std::ifstream file(fixture("clip.mkv"), std::ios::binary);
+        const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Decoder buffered;
+        buffered.open(InputSource::fromBuffer(bytes, "clip.mkv"));
+        const auto fromMemory = decodeAll(buffered);
+        bool same = fromMemory.size() == frames.size();
+        for (std::size_t k = 0; same && k < frames.size(); k++) {
+            same = fromMemory[k].first.data == frames[k].first.data && fromMemory[k].second == frames[k].second;
+        }
+        expect(same, "InputSource::fromBuffer: decodes like the file");
+        expect(buffered.readFrameAt(1.0, frame) && markerIndex(frame, 32) == 12 && frame.data == frames[12].first.data,
+               "InputSource::fromBuffer: seekable for readFrameAt");
+
+        // Corrupt packets are skipped by default and stop the decode when asked
+        std::vector<uint8_t> damaged = bytes;
+        for (std::size_t i = damaged.size() / 3; i < damaged.size() / 3 + 400; i++) damaged[i] ^= 0x5A;
+        Decoder skipping;
+        skipping.open(InputSource::fromBuffer(damaged, "damaged.mkv"));
+        const auto survived = decodeAll(skipping);
+        expect(!survived.empty() && survived.size() < 48 && markerIndex(survived.back().first, 32) == 47,
+               "Decoder: skips corrupt packets and reaches the end");
+        Decoder strict;
+        strict.setSkipCorruptPackets(false);
+        strict.open(InputSource::fromBuffer(damaged, "damaged.mkv"));
+        engine::Expected<void> read;
+        while ((read = strict.readFrame_RGB24(frame))) {
+        }
+        expect(read.is(engine::ErrorCode::CorruptData), "Decoder: CorruptData without skipping");
+
+        // readFrameAt: the frame on screen at the time, then the cache; sequential reads don't fill it
+        engine::io::FrameCache cache;
+        Decoder random;
+        random.setFrameCache(&cache);
+        random.open(fixture("clip.mkv"));
+        expect(random.readFrameAt(2.5, frame) && frame.data == frames[30].first.data &&
+               random.readFrameAt(0.55, frame) && frame.data == frames[6].first.data,
+               "Decoder::readFrameAt: frame on screen, forwards and backwards");
+        expect(cache.stats().misses == 2 && cache.stats().hits == 0 && cache.stats().frames == 2,
+               "Decoder::readFrameAt: decoded frames are cached");
+        (void) random.readFrame_RGB24(frame);
+        expect(cache.stats().frames == 2, "Decoder: sequential reads are not cached");
+        Decoder other;
+        other.setFrameCache(&cache);
+        other.open(fixture("clip.mkv"));
+        const int64_t before = engine::utils::nowNanos();
+        expect(other.readFrameAt(2.54, frame) && frame.data == frames[30].first.data && frame.arrival >= before &&
+               cache.stats().hits == 1, "FrameCache: hit across decoders, arrival restamped");
+
+        // Low latency: the newest frame wins, everything is either delivered or dropped
+        Decoder live;
+        live.setLowLatency(true);
+        live.open(fixture("clip.mkv"));
+        engine::Pipeline pipeline;
+        pipeline.setLowLatency(true);
+        std::vector<int> delivered;
+        const std::size_t count = pipeline.run(128, 96, PixelFormat::RGB24, [&](Frame &f) {
+            return live.readFrame_RGB24(f);
+        }, [&](Frame &f) {
+            delivered.push_back(markerIndex(f, 32));
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }, [&] { live.interrupt(); });
+        expect(count == delivered.size() && count + pipeline.stats().dropped == 48 && delivered.back() == 47 &&
+               std::is_sorted(delivered.begin(), delivered.end()) &&
+               std::adjacent_find(delivered.begin(), delivered.end()) == delivered.end(),
+               "Pipeline low latency: newest frames of a real decoder, the last one delivered");
+
+        // KeyframeSampler: the first keyframe at or after each time, until the end
+        engine::io::KeyframeSampler sampler(fixture("clip.mkv"), 32, 24);
+        Frame sample(32, 24, PixelFormat::RGB24);
+        const auto first = sampler.next(0, sample);
+        const auto second = sampler.next(0.5, sample);
+        expect(sampler.canSeek() && first && *first == 0 && second && *second == 1.0 && markerIndex(sample, 8) == 12 &&
+               sampler.next(4.5, sample).is(engine::ErrorCode::EndOfStream), "KeyframeSampler: keyframes in order");
+
+        // Sprite sheet of 3 x 2 tiles spread over 4 s: the 4 keyframes in the first tiles, the rest blank
+        engine::io::SpriteSheetOptions layout;
+        layout.columns = 3;
+        layout.rows = 2;
+        layout.tileWidth = 32;
+        const auto sheet = engine::io::Thumbnailer::createSpriteSheet(fixture("clip.mkv"), layout);
+        bool placed = sheet && sheet->tileHeight == 24 && sheet->sheet.width == 96 && sheet->sheet.height == 48 &&
+                      sheet->timestamps == std::vector<double>{0, 1, 2, 3};
+        for (int tile = 0; placed && tile < 6; tile++) {
+            const auto view = sheet->sheet.view((tile % 3) * 32, (tile / 3) * 24, 32, 24);
+            if (tile < 4) {
+                placed = markerIndex(view, 8) == tile * 12;
+                continue;
+            }
+            for (int y = 0; y < view.height; y++) {
+                placed = placed && std::all_of(view.row(y), view.row(y) + view.rowBytes(), [](const uint8_t v) {
+                    return v == 0;
+                });
+            }
+        }
+        expect(placed, "Thumbnailer: keyframe tiles in place with their times, leftover tiles blank");
+
+        // An all-keyframe mjpeg clip at a quarter of its size, which it decodes at reduced resolution
+        layout.columns = 4;
+        layout.rows = 1;
+        layout.interval = 0.25;
+        const auto small = engine::io::Thumbnailer::createSpriteSheet(fixture("clip_mjpeg.mkv"), layout);
+        bool quarter = small && small->timestamps == std::vector<double>{0, 0.25, 0.5, 0.75};
+        for (int tile = 0; quarter && tile < 4; tile++) {
+            quarter = markerIndex(small->sheet.view(tile * 32, 0, 32, 24), 8) == tile * 3;
+        }
+        expect(quarter, "Thumbnailer: lowres mjpeg tiles");
+        layout.rows = 0;
+        expect(engine::io::Thumbnailer::createSpriteSheet(fixture("clip.mkv"), layout).is(
+                   engine::ErrorCode::InvalidArgument), "Thumbnailer: rejects an empty layout");
+
+        // Fingerprints survive a re-encode at another size and quality, and tell different videos apart
+        const auto original = engine::io::Fingerprinter::fingerprint(fixture("clip.mkv"));
+        const auto reencoded = engine::io::Fingerprinter::fingerprint(fixture("clip_reencoded.mkv"));
+        engine::FrameHasher hasher(1.0, [](const int64_t pts) { return static_cast<double>(pts) / 4; });
+        for (int i = 0; i < 16; i++) {
+            Frame scene = makeScene(160, 90, i / 4 % 3);
+            scene.pts = i;
+            (void) hasher.process(scene);
+        }
+        expect(original && reencoded && original->hashes.size() == 4 && reencoded->hashes.size() == 4 &&
+               original->distance(*reencoded) <= 8 && original->distance(hasher.signature()) >= 16,
+               "Fingerprinter: stable across a re-encode");
+    }
+
+    int runChecks() {
+        if (optimisedLevels().empty()) {
+            logger::warn("engine_tests: this CPU has no optimised kernels, only the scalar paths run");
+        }
+
+        checkRowKernels();
+        checkBlockKernels();
+        checkFrameOperations();
+        checkFingerprints();
+        checkExpected();
+        checkStages();
+        checkConfig();
+        checkInputSources();
+        checkFrameCache();
+        checkDecoding();
+
+        if (failures) {
+            logger::error("engine_tests: {} of {} checks failed", failures, checks);
+            return 1;
+        }
+        logger::success("engine_tests: {} checks passed", checks);
+        return 0;
+    }
+
+    // =====================
+    // Performance
+    // =====================
+
+    struct PerfOptions {
+        double minSpeedup = 1.0;
+        double tolerance = 0.2;
+        std::string baseline;
+        std::string writeBaseline;
     };
 
-    const int bytePerPixel = frame.bytesPerPixel();
+    // Best of several timed runs, in megabytes (or megapixels, per benchmark) per second
+    double throughput(const double megabytes, const std::function<void()> &fn) {
+        using Clock = std::chrono::steady_clock;
+        fn(); // warm-up: page faults, thread pool start
+        double best = 0;
+        for (int run = 0; run < 7; run++) {
+            const auto start = Clock::now();
+            fn();
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            best = std::max(best, megabytes / std::max(seconds, 1e-9));
+        }
+        return best;
+    }
+
+    std::map<std::string, double> readBaseline(const std::string &path) {
+        std::map<std::string, double> values;
+        std::ifstream file(path);
+        std::string name;
+        double value = 0;
+        while (file >> name >> value) {
+            values[name] = value;
+        }
+        return values;
+    }
+
+    int runPerf(const PerfOptions &options) {
+        if (kDebugBuild) {
+            logger::warn("engine_tests --perf: debug build, throughput is not meaningful; skipped");
+            return kSkipped;
+        }
+
+        const auto levels = optimisedLevels();
+        const cpu::SimdLevel best = levels.empty() ? cpu::SimdLevel::Scalar : levels.back();
+
+        const auto gray = makeClip(1920, 1080, PixelFormat::GRAY8, 2, 7);
+        const auto rgb = makeClip(1920, 1080, PixelFormat::RGB24, 1, 8);
+        const auto rgba = makeClip(1920, 1080, PixelFormat::RGBA32, 2, 9);
+        const double pixels = 1920.0 * 1080.0 / 1e6;
+
+        Frame scratchRgba = rgba[0];
+        Frame scratchGray = gray[0];
+        Frame scaled(1280, 720, PixelFormat::RGB24);
+        const auto kernel = engine::Kernel1D::gaussian(2.0);
+        std::vector<uint8_t> row(1920 * 4);
+
+        // 1920 -> 1280 RGB24 columns for resizeRow
+        std::vector<int32_t> columns(1280);
+        std::vector<uint16_t> columnWeights(1280);
+        for (int x = 0; x < 1280; x++) {
+            const double position = (x + 0.5) * 1920 / 1280 - 0.5;
+            columns[x] = static_cast<int32_t>(position) * 3;
+            columnWeights[x] = static_cast<uint16_t>(std::lround((position - static_cast<int>(position)) * 256));
+        }
+
+        // Throughput in megapixels per second of one 1080p frame
+        const std::vector<std::pair<std::string, std::function<void()> > > benchmarks = {
+            {"sad", [&] {
+                volatile uint64_t sink = 0;
+                for (int y = 0; y < 1080; y++) sink = sink + cpu::sad(gray[0].row(y), gray[1].row(y), 1920);
+            }},
+            {"weightedSum", [&] {
+                const uint8_t *sources[cpu::kMaxTaps];
+                const int taps = static_cast<int>(kernel.weights.size());
+                for (int y = 0; y + taps <= 1080; y++) {
+                    for (int k = 0; k < taps; k++) sources[k] = gray[0].row(y + k);
+                    cpu::weightedSum(sources, kernel.weights.data(), taps, row.data(), 1920);
+                }
+            }},
+            {"unsharp", [&] {
+                for (int y = 0; y < 1080; y++) cpu::unsharp(gray[0].row(y), gray[1].row(y), 12, row.data(), 1920);
+            }},
+            {"sobel", [&] {
+                for (int y = 1; y < 1079; y++) {
+                    cpu::sobel(gray[0].row(y - 1) + 1, gray[0].row(y) + 1, gray[0].row(y + 1) + 1, row.data(), 1918);
+                }
+            }},
+            {"temporalBlend", [&] {
+                for (int y = 0; y < 1080; y++) {
+                    const uint8_t *history[4] = {gray[1].row(y), gray[1].row(y), gray[1].row(y), gray[1].row(y)};
+                    cpu::temporalBlend(gray[0].row(y), history, 4, 12, row.data(), 1920);
+                }
+            }},
+            {"grayInPlace", [&] {
+                for (int y = 0; y < 1080; y++) cpu::grayInPlace(scratchRgba.row(y), 4, 1920);
+            }},
+            {"rgbToRgba", [&] {
+                for (int y = 0; y < 1080; y++) cpu::rgbToRgba(rgb[0].row(y), row.data(), 1920);
+            }},
+            {"rgbaToRgb", [&] {
+                for (int y = 0; y < 1080; y++) cpu::rgbaToRgb(rgba[0].row(y), row.data(), 1920);
+            }},
+            {"grayToRgb", [&] {
+                for (int y = 0; y < 1080; y++) cpu::grayToRgb(gray[0].row(y), 4, row.data(), 1920);
+            }},
+            {"lumaFromRGB", [&] {
+                for (int y = 0; y < 1080; y++) cpu::lumaFromRGB(rgb[0].row(y), 3, row.data(), 1920);
+            }},
+            {"resizeRow", [&] {
+                for (int y = 0; y < 1080; y++) {
+                    cpu::resizeRow(rgb[0].row(y), 3, columns.data(), columnWeights.data(), row.data(), 1280);
+                }
+            }},
+            {"premultiply", [&] {
+                for (int y = 0; y < 1080; y++) cpu::premultiply(rgba[0].row(y), row.data(), 1920);
+            }},
+            {"blendPremultiplied", [&] {
+                for (int y = 0; y < 1080; y++) cpu::blendPremultiplied(rgba[1].row(y), scratchRgba.row(y), 4, 1920);
+            }},
+            {"dctLowFrequency", [&] {
+                int32_t coefficients[cpu::kDctTerms * cpu::kDctTerms];
+                for (int y = 0; y + cpu::kDctBlock <= 1080; y += cpu::kDctBlock) {
+                    for (int x = 0; x + cpu::kDctBlock <= 1920; x += cpu::kDctBlock) {
+                        cpu::dctLowFrequency(gray[0].row(y) + x, gray[0].stride, coefficients);
+                    }
+                }
+            }},
+            {"Engine::resize", [&] { (void) engine::Engine::resize(rgb[0], scaled); }},
+            {"Filters::gaussianBlur", [&] { (void) engine::Filters::gaussianBlur(scratchGray, 2.0); }},
+        };
+
+        const auto baseline = options.baseline.empty()
+                                  ? std::map<std::string, double>{}
+                                  : readBaseline(options.baseline);
+        if (!options.baseline.empty() && baseline.empty()) {
+            logger::error("engine_tests --perf: no baseline values in {}", options.baseline);
+            return 1;
+        }
+
+        std::map<std::string, double> measured;
+        int regressions = 0;
+        for (const auto &[name, fn]: benchmarks) {
+            cpu::setSimdLevel(cpu::SimdLevel::Scalar);
+            const double scalar = throughput(pixels, fn);
+            cpu::setSimdLevel(best);
+            const double optimised = throughput(pixels, fn);
+            measured[name] = optimised;
 
-    for (int y = 102; y < 977; y++) {
-        uint8_t *row = frame.row(y);
-        for (int x = 92; x < 1828; x++) {
-            if (bitmap[(y - 102) / 125][(x - 92) / 62] == 1) {
-                row[x * bytePerPixel + 3] = static_cast<uint8_t>(100);
+            const double speedup = optimised / scalar;
+            logger::info("{:<22} {:>9.1f} MPix/s  scalar {:>9.1f} MPix/s  x{:.2f}", name, optimised, scalar, speedup);
+
+            if (!levels.empty() && speedup < options.minSpeedup) {
+                logger::error("{}: {} is only x{:.2f} the scalar throughput (minimum x{:.2f})", name,
+                              levelName(best), speedup, options.minSpeedup);
+                regressions++;
+            }
+            if (const auto it = baseline.find(name); it != baseline.end() &&
+                                                     optimised < it->second * (1.0 - options.tolerance)) {
+                logger::error("{}: {:.1f} MPix/s is more than {:.0f}% below the baseline {:.1f} MPix/s", name,
+                              optimised, options.tolerance * 100, it->second);
+                regressions++;
             }
         }
+        cpu::setSimdLevel(cpu::detectSimdLevel());
+
+        if (!options.writeBaseline.empty()) {
+            std::ofstream file(options.writeBaseline);
+            for (const auto &[name, value]: measured) {
+                file << name << " " << value << "\n";
+            }
+            if (!file.flush()) {
+                logger::error("engine_tests --perf: could not write {}", options.writeBaseline);
+                return 1;
+            }
+            logger::success("engine_tests --perf: baseline written to {}", options.writeBaseline);
+        }
+
+        if (regressions) {
+            logger::error("engine_tests --perf: {} throughput regressions", regressions);
+            return 1;
+        }
+        logger::success("engine_tests --perf: throughput within thresholds");
+        return 0;
     }
 }
 
-int main() {
-    using engine::utils::Logger::error;
-    using engine::utils::Logger::info;
-    using engine::utils::Logger::success;
-    using engine::utils::Logger::warn;
-
-    const char *filepath = openFileDialog();
-
-    if (!filepath) {
-        error("No file was selected.");
-        return 1;
-    }
-
-    io::Decoder decoder;
-
-    decoder.open(filepath);
-
-    const double fps = decoder.getFPS(filepath);
-
-    std::cout << "FPS: " << fps << "\n";
-
-    // try {
-    //     io::Decoder decoder;
-    //     decoder.open(filepath);
-    //
-    //     engine::Frame frame(decoder.getWidth(), decoder.getHeight(), engine::PixelFormat::RGBA32);
-    //
-    //     int frameCount = 0;
-    //
-    //     while (decoder.readFrame_RGBA32(frame)) {
-    //         frameCount++;
-    //         if (frameCount % 30 == 0) {
-    //             info("Decoded frame {}", frameCount);
-    //         }
-    //
-    //         if (frameCount % 100 == 0) {
-    //             addBlueMark(frame);
-    //             engine::Engine::savePAM(frame, "./test/debug_frame" + std::to_string(frameCount) + ".pam");
-    //             success("Snapshot of frame {} has been successfully saved.", frameCount);
-    //         }
-    //     }
-    //
-    //     success("Finished! Total Frames: {}", frameCount);
-    // } catch (std::exception &e) {
-    //     error("Error: {}", e.what());
-    // }
-
-    return 0;
+int main(const int argc, char **argv) {
+    bool perf = false;
+    PerfOptions options;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--perf") {
+            perf = true;
+        } else if (arg == "--min-speedup" && hasValue) {
+            options.minSpeedup = std::atof(argv[++i]);
+        } else if (arg == "--tolerance" && hasValue) {
+            options.tolerance = std::atof(argv[++i]);
+        } else if (arg == "--baseline" && hasValue) {
+            options.baseline = argv[++i];
+        } else if (arg == "--write-baseline" && hasValue) {
+            options.writeBaseline = argv[++i];
+        } else {
+            logger::error("usage: engine_tests [--perf [--min-speedup X] [--tolerance T] [--baseline FILE] "
+                          "[--write-baseline FILE]]");
+            logger::flush();
+            return 2;
+        }
+    }
+
+    // Pick the backend up front; its activation would otherwise reset the SIMD level mid-comparison
+    engine::Backend::active();
+
+    int result = 1;
+    try {
+        result = perf ? runPerf(options) : runChecks();
+    } catch (const std::exception &e) {
+        logger::error("engine_tests: {}", e.what());
+    }
+    logger::flush();
+    return result;
 }